@@ -0,0 +1,70 @@
+#include <iostream>
+#include "bracket_index.h"
+
+static TokenType openerFor(TokenType closer) {
+    return closer == RIGHT_PAREN ? LEFT_PAREN : LEFT_BRACE;
+}
+
+static char bracketChar(TokenType type) {
+    switch (type) {
+        case LEFT_PAREN: return '(';
+        case RIGHT_PAREN: return ')';
+        case LEFT_BRACE: return '{';
+        default: return '}';
+    }
+}
+
+void BracketIndex::clear() {
+    partners.clear();
+    stack.clear();
+    errors = 0;
+}
+
+void BracketIndex::reportUnclosed(const OpenBracket& open) {
+    if (reportErrors) *errorStream << "[Line " << open.line << "] Error: Unclosed '"
+                 << bracketChar(open.type) << "'." << std::endl;
+    errors++;
+}
+
+void BracketIndex::add(TokenType type, int line) {
+    int index = static_cast<int>(partners.size());
+    partners.push_back(-1);
+
+    switch (type) {
+        case LEFT_PAREN:
+        case LEFT_BRACE:
+            stack.push_back({index, type, line});
+            break;
+        case RIGHT_PAREN:
+        case RIGHT_BRACE: {
+            TokenType opener = openerFor(type);
+            // Find the nearest opener of the same kind. Anything above it was
+            // never closed, e.g. the '(' in "{ ( }".
+            int depth = static_cast<int>(stack.size()) - 1;
+            while (depth >= 0 && stack[depth].type != opener) depth--;
+            if (depth < 0) {
+                if (reportErrors) {
+                    *errorStream << "[Line " << line << "] Error: Unmatched '"
+                                 << bracketChar(type) << "'." << std::endl;
+                }
+                errors++;
+                break;
+            }
+            while (static_cast<int>(stack.size()) - 1 > depth) {
+                reportUnclosed(stack.back());
+                stack.pop_back();
+            }
+            partners[stack.back().index] = index;
+            partners[index] = stack.back().index;
+            stack.pop_back();
+            break;
+        }
+        default:
+            break;
+    }
+}
+
+void BracketIndex::finish() {
+    for (const OpenBracket& open : stack) reportUnclosed(open);
+    stack.clear();
+}
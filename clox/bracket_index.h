@@ -0,0 +1,52 @@
+#ifndef CLOX_BRACKET_INDEX_H
+#define CLOX_BRACKET_INDEX_H
+
+#include <iostream>
+#include <vector>
+#include "token.h"
+
+// Pairs up '(' / ')' and '{' / '}' tokens while a scanner emits them, so
+// later stages can jump from a bracket to its partner in O(1) instead of
+// making another pass over the token list.
+class BracketIndex
+{
+private:
+    struct OpenBracket {
+        int index;
+        TokenType type;
+        int line;
+    };
+
+    // Parallel to the token list; -1 for non-brackets and unmatched ones.
+    std::vector<int> partners;
+    std::vector<OpenBracket> stack;
+    int errors = 0;
+    bool reportErrors;
+    std::ostream* errorStream = &std::cerr;
+
+    void reportUnclosed(const OpenBracket& open);
+
+public:
+    // With reportErrors off, unbalanced brackets are only counted.
+    explicit BracketIndex(bool reportErrors = true) : reportErrors(reportErrors) {}
+
+    // Keeps the buffers' capacity so scanners can reuse the index.
+    void clear();
+    // Must be called for every token, in order, including TOKEN_EOF.
+    void add(TokenType type, int line);
+    void add(const Token& token) { add(token.type, token.line); }
+    // Reports any brackets still open at the end of the input.
+    void finish();
+
+    // Number of tokens added since clear().
+    int size() const { return static_cast<int>(partners.size()); }
+    int partnerOf(int tokenIndex) const {
+        if (tokenIndex < 0 || tokenIndex >= static_cast<int>(partners.size())) return -1;
+        return partners[tokenIndex];
+    }
+    bool balanced() const { return errors == 0; }
+    int errorCount() const { return errors; }
+    void setErrorStream(std::ostream& stream) { errorStream = &stream; }
+};
+
+#endif
@@ -0,0 +1,23 @@
+#include <algorithm>
+#include "chunk.h"
+
+void Chunk::write(uint8_t byte, int line) {
+    if (lines.empty() || lines.back().line != line) {
+        lines.push_back({static_cast<int>(code.size()), line});
+    }
+    code.push_back(byte);
+}
+
+int Chunk::addConstant(Value value) {
+    constants.push_back(value);
+    return static_cast<int>(constants.size()) - 1;
+}
+
+int Chunk::getLine(int offset) const {
+    if (lines.empty()) return 0;
+    // The last run starting at or before `offset`.
+    auto run = std::upper_bound(lines.begin(), lines.end(), offset,
+        [](int value, const LineStart& start) { return value < start.offset; });
+    if (run == lines.begin()) return lines.front().line;
+    return (run - 1)->line;
+}
@@ -0,0 +1,36 @@
+#ifndef CLOX_CHUNK_H
+#define CLOX_CHUNK_H
+
+#include <cstdint>
+#include <vector>
+#include "value.h"
+
+// A sequence of bytecode with its constants and source line table.
+//
+// Lines come from Token::line. Consecutive instructions usually share a
+// line, so the table stores one entry per change of line rather than one
+// per byte; getLine() is a binary search over those entries.
+class Chunk
+{
+private:
+    struct LineStart {
+        int offset;
+        int line;
+    };
+
+    std::vector<uint8_t> code;
+    std::vector<Value> constants;
+    std::vector<LineStart> lines;
+
+public:
+    void write(uint8_t byte, int line);
+    int addConstant(Value value);
+    // Source line of the instruction containing the byte at `offset`.
+    int getLine(int offset) const;
+
+    const uint8_t* bytes() const { return code.data(); }
+    int size() const { return static_cast<int>(code.size()); }
+    Value constant(int index) const { return constants[index]; }
+};
+
+#endif
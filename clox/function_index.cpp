@@ -0,0 +1,92 @@
+#include <stdexcept>
+#include "function_index.h"
+
+// Matches "name ( params ) {" starting at `nameToken` and fills in the
+// ranges. Returns false if the shape does not match or the brackets are
+// unbalanced.
+static bool matchSignature(const std::vector<Token>& tokens, const BracketIndex& brackets,
+                           int nameToken, int last, FunctionRange& range) {
+    int paramsStart = nameToken + 1;
+    if (paramsStart >= last || tokens[paramsStart].type != LEFT_PAREN) return false;
+    int paramsEnd = brackets.partnerOf(paramsStart);
+    if (paramsEnd < 0 || paramsEnd + 1 >= last) return false;
+    int bodyStart = paramsEnd + 1;
+    if (tokens[bodyStart].type != LEFT_BRACE) return false;
+    int bodyEnd = brackets.partnerOf(bodyStart);
+    if (bodyEnd < 0 || bodyEnd >= last) return false;
+
+    range.nameToken = nameToken;
+    range.paramsStart = paramsStart;
+    range.paramsEnd = paramsEnd;
+    range.bodyStart = bodyStart;
+    range.bodyEnd = bodyEnd;
+    range.line = tokens[nameToken].line;
+    return true;
+}
+
+// Indexes the methods of a class body [bodyStart, bodyEnd], skipping any
+// that do not match.
+static void indexMethods(const std::vector<Token>& tokens, const BracketIndex& brackets,
+                         const std::string& className, int bodyStart, int bodyEnd,
+                         std::vector<FunctionRange>& functions) {
+    int i = bodyStart + 1;
+    while (i < bodyEnd) {
+        FunctionRange range;
+        if (tokens[i].type != IDENTIFIER || !matchSignature(tokens, brackets, i, bodyEnd, range)) {
+            i++;
+            continue;
+        }
+        range.name = className + "." + tokens[i].lexeme;
+        functions.push_back(range);
+        i = range.bodyEnd + 1;
+    }
+}
+
+std::vector<FunctionRange> indexFunctions(const std::vector<Token>& tokens,
+                                          const BracketIndex& brackets,
+                                          int first, int last) {
+    if (brackets.size() != static_cast<int>(tokens.size())) {
+        throw std::invalid_argument(
+            "indexFunctions: bracket index does not cover the tokens; scan with IndexedScan.");
+    }
+    std::vector<FunctionRange> functions;
+    int i = first;
+    while (i < last) {
+        TokenType type = tokens[i].type;
+        if (type == FUN && i + 1 < last && tokens[i + 1].type == IDENTIFIER) {
+            FunctionRange range;
+            if (!matchSignature(tokens, brackets, i + 1, last, range)) {
+                // Not a complete declaration; resume after the name.
+                i += 2;
+                continue;
+            }
+            range.name = tokens[i + 1].lexeme;
+            functions.push_back(range);
+            // Skip the whole body in one step.
+            i = range.bodyEnd + 1;
+        } else if (type == CLASS && i + 1 < last && tokens[i + 1].type == IDENTIFIER) {
+            int bodyStart = i + 2;
+            // Optional superclass: "class Name < Super {".
+            if (bodyStart + 1 < last && tokens[bodyStart].type == LESS) bodyStart += 2;
+            if (bodyStart >= last || tokens[bodyStart].type != LEFT_BRACE) {
+                i++;
+                continue;
+            }
+            int bodyEnd = brackets.partnerOf(bodyStart);
+            if (bodyEnd < 0 || bodyEnd >= last) {
+                i = bodyStart + 1;
+                continue;
+            }
+            indexMethods(tokens, brackets, tokens[i + 1].lexeme, bodyStart, bodyEnd, functions);
+            i = bodyEnd + 1;
+        } else if (type == LEFT_BRACE) {
+            // A block, e.g. an if or loop body: whatever it declares is
+            // local to it, not to this range.
+            int blockEnd = brackets.partnerOf(i);
+            i = blockEnd > i && blockEnd < last ? blockEnd + 1 : i + 1;
+        } else {
+            i++;
+        }
+    }
+    return functions;
+}
@@ -0,0 +1,91 @@
+#ifndef CLOX_FUNCTION_INDEX_H
+#define CLOX_FUNCTION_INDEX_H
+
+#include <functional>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+#include "bracket_index.h"
+#include "token.h"
+
+// Token ranges of one function or method declaration. Indices point into
+// the scanner's token list; the body is [bodyStart, bodyEnd], braces
+// included.
+struct FunctionRange {
+    std::string name;       // "name", or "Class.name" for methods
+    int nameToken;
+    int paramsStart;        // LEFT_PAREN
+    int paramsEnd;          // RIGHT_PAREN
+    int bodyStart;          // LEFT_BRACE
+    int bodyEnd;            // RIGHT_BRACE
+    int line;
+};
+
+// Finds the functions and methods declared directly in tokens [first, last),
+// jumping over each body through the bracket index instead of walking it.
+// Functions nested inside a body are found by indexing that body later;
+// ones declared in a block ({ ... } of an if, loop or bare block) are local
+// to it and not indexed.
+// Malformed declarations, including ones with unbalanced brackets, are
+// skipped. `brackets` must have been built for `tokens` (a scanner with
+// IndexedScan); otherwise std::invalid_argument is thrown, since every
+// lookup would fail and nothing would be indexed.
+std::vector<FunctionRange> indexFunctions(const std::vector<Token>& tokens,
+                                          const BracketIndex& brackets,
+                                          int first, int last);
+
+// Records only token ranges up front and runs `compile` on a body the first
+// time it is requested, caching the result. Startup cost is one skip per
+// declaration; compile cost is paid only for functions that are used.
+// `tokens` and `brackets` must outlive the table.
+template <typename Compiled>
+class LazyFunctionTable
+{
+public:
+    using Compiler = std::function<Compiled(const FunctionRange&)>;
+
+private:
+    std::vector<FunctionRange> functions;
+    std::unordered_map<std::string_view, size_t> byName;
+    std::vector<std::unique_ptr<Compiled>> compiled;
+    Compiler compile;
+    size_t compiledCount = 0;
+
+public:
+    LazyFunctionTable(const std::vector<Token>& tokens, const BracketIndex& brackets,
+                      Compiler compile)
+        : functions(indexFunctions(tokens, brackets, 0, static_cast<int>(tokens.size()))),
+          compiled(functions.size()),
+          compile(std::move(compile)) {
+        // A later declaration with the same name replaces the earlier one.
+        for (size_t i = 0; i < functions.size(); i++) byName[functions[i].name] = i;
+    }
+
+    // byName views the names stored in `functions`.
+    LazyFunctionTable(const LazyFunctionTable&) = delete;
+    LazyFunctionTable& operator=(const LazyFunctionTable&) = delete;
+
+    const FunctionRange* find(std::string_view name) const {
+        auto found = byName.find(name);
+        return found == byName.end() ? nullptr : &functions[found->second];
+    }
+
+    // Returns nullptr if no function has this name.
+    const Compiled* get(std::string_view name) {
+        auto found = byName.find(name);
+        if (found == byName.end()) return nullptr;
+        std::unique_ptr<Compiled>& slot = compiled[found->second];
+        if (!slot) {
+            slot = std::make_unique<Compiled>(compile(functions[found->second]));
+            compiledCount++;
+        }
+        return slot.get();
+    }
+
+    size_t declaredFunctions() const { return functions.size(); }
+    size_t compiledFunctions() const { return compiledCount; }
+};
+
+#endif
@@ -0,0 +1,95 @@
+#include <iostream>
+#include <string>
+#include <vector>
+#include "memory.h"
+
+int main() {
+    std::cout << "=== Object Heap Test ===" << std::endl << std::endl;
+
+    // Test 1
+    std::cout << "Test 1: Rooted objects survive, garbage is freed" << std::endl;
+    HeapOptions options;
+    options.initialThreshold = 64 * 1024;
+    Heap heap(options);
+    std::vector<Value> stack;
+    heap.setRootMarker([&](Heap& h) {
+        for (Value value : stack) h.markValue(value);
+    });
+
+    ObjInstance* point = heap.newInstance(heap.intern("Point"));
+    stack.push_back(Value::object(&point->obj));
+    heap.setField(point, heap.intern("x"), Value::number(1));
+    ObjString* origin = heap.intern("origin");
+    heap.setField(point, heap.intern("label"), Value::object(&origin->obj));
+    for (int i = 0; i < 10000; i++) {
+        heap.intern("temp" + std::to_string(i));
+    }
+    heap.collectGarbage();
+    Value label;
+    point->fields.get(heap.intern("label"), &label);
+    std::cout << "Point.label: " << reinterpret_cast<ObjString*>(label.as.obj)->view() << '\n';
+    std::cout << "Interned strings after collection: " << heap.internedStrings() << std::endl;
+    std::cout << std::endl;
+
+    // Test 2
+    std::cout << "Test 2: Closures keep their function and captures alive" << std::endl;
+    ObjFunction* function = heap.newFunction(heap.intern("counter"), 0, 1);
+    stack.push_back(Value::object(&function->obj));
+    ObjClosure* closure = heap.newClosure(function);
+    stack.pop_back();
+    stack.push_back(Value::object(&closure->obj));
+    closure->upvalues()[0] = Value::object(&heap.newInstance(heap.intern("Box"))->obj);
+    heap.collectGarbage();
+    ObjInstance* box = reinterpret_cast<ObjInstance*>(closure->upvalues()[0].as.obj);
+    std::cout << "Closure of " << closure->function->name->view()
+              << " captures a " << box->className->view() << std::endl;
+    std::cout << std::endl;
+
+    // Test 3
+    std::cout << "Test 3: Freed blocks are reused" << std::endl;
+    size_t arenaBefore = heap.stats().arenaBytes;
+    for (int round = 0; round < 20; round++) {
+        for (int i = 0; i < 5000; i++) heap.newInstance(heap.intern("Garbage"));
+        heap.collectGarbage();
+    }
+    std::cout << "Arena growth after warm-up: " << heap.stats().arenaBytes - arenaBefore
+              << " bytes" << std::endl;
+    std::cout << std::endl;
+
+    // Test 4
+    std::cout << "Test 4: Stress mode" << std::endl;
+    HeapOptions stressOptions;
+    stressOptions.stressGC = true;
+    Heap stressHeap(stressOptions);
+    ObjString* kept = stressHeap.intern("kept");
+    stressHeap.pushRoot(Value::object(&kept->obj));
+    for (int i = 0; i < 100; i++) stressHeap.intern("x" + std::to_string(i));
+    std::cout << "Collections: " << stressHeap.stats().collections << '\n';
+    std::cout << "Still interned: " << (stressHeap.intern("kept") == kept ? "yes" : "no") << std::endl;
+    stressHeap.popRoot();
+    std::cout << std::endl;
+
+    // Test 5
+    std::cout << "Test 5: Field storage counts as live bytes" << std::endl;
+    Heap fieldHeap;
+    ObjInstance* record = fieldHeap.newInstance(fieldHeap.intern("Record"));
+    fieldHeap.pushRoot(Value::object(&record->obj));
+    size_t liveBefore = fieldHeap.stats().liveBytes;
+    std::vector<ObjString*> names;
+    for (int i = 0; i < 1000; i++) names.push_back(fieldHeap.intern("f" + std::to_string(i)));
+    size_t namesBytes = fieldHeap.stats().liveBytes - liveBefore;
+    for (int i = 0; i < 1000; i++) fieldHeap.setField(record, names[i], Value::number(i));
+    std::cout << "Field table bytes counted: "
+              << fieldHeap.stats().liveBytes - liveBefore - namesBytes
+              << " (capacity " << record->fields.capacity() << ")" << '\n';
+    fieldHeap.popRoot();
+    fieldHeap.collectGarbage();
+    std::cout << "Live bytes after freeing it: " << fieldHeap.stats().liveBytes << std::endl;
+    std::cout << std::endl;
+
+    // Test 6
+    std::cout << "Test 6: Statistics" << std::endl;
+    heap.printStats(std::cout);
+
+    return 0;
+}
@@ -0,0 +1,97 @@
+#include "function_index.h"
+#include "isolate.h"
+
+Isolate::Isolate(HeapOptions options) : heap(options) {
+    scanner.setErrorStream(diagnostics);
+    heap.setRootMarker([this](Heap& h) {
+        for (Value value : stack) h.markValue(value);
+        h.markTable(globals);
+    });
+}
+
+void Isolate::reset() {
+    globals.clear();
+    stack.clear();
+    diagnostics.str(std::string());
+    diagnostics.clear();
+}
+
+ScriptResult Isolate::run(const std::string& source) {
+    reset();
+    ScriptResult result;
+
+    scanner.reset(source);
+    const std::vector<Token>& tokens = scanner.scanTokens();
+    const BracketIndex& brackets = scanner.bracketIndex();
+    result.tokens = static_cast<int>(tokens.size());
+
+    std::vector<FunctionRange> functions =
+        indexFunctions(tokens, brackets, 0, static_cast<int>(tokens.size()));
+    for (const FunctionRange& range : functions) {
+        // Methods are bound when their class is, and functions declared in
+        // a block are not indexed; only top-level functions become globals.
+        if (range.name.find('.') != std::string::npos) continue;
+
+        int arity = 0;
+        for (int i = range.paramsStart + 1; i < range.paramsEnd; i++) {
+            if (tokens[i].type == IDENTIFIER) arity++;
+        }
+        ObjString* name = heap.intern(range.name);
+        ObjFunction* function = heap.newFunction(name, arity, 0);
+        function->bodyStart = range.bodyStart;
+        function->bodyEnd = range.bodyEnd;
+        globals.set(name, Value::object(&function->obj));
+        result.functions++;
+    }
+
+    result.globals = globals.size();
+    result.diagnostics = diagnostics.str();
+    result.ok = result.diagnostics.empty();
+    return result;
+}
+
+IsolateScheduler::IsolateScheduler(unsigned threads) {
+    if (threads == 0) threads = std::thread::hardware_concurrency();
+    if (threads == 0) threads = 1;
+    for (unsigned i = 0; i < threads; i++) {
+        workers.emplace_back([this] { workerLoop(); });
+    }
+}
+
+IsolateScheduler::~IsolateScheduler() {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+    }
+    available.notify_all();
+    for (std::thread& worker : workers) worker.join();
+}
+
+std::future<ScriptResult> IsolateScheduler::submit(std::string source) {
+    std::packaged_task<ScriptResult(Isolate&)> job(
+        [source = std::move(source)](Isolate& isolate) { return isolate.run(source); });
+    std::future<ScriptResult> result = job.get_future();
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        jobs.push_back(std::move(job));
+    }
+    available.notify_one();
+    return result;
+}
+
+void IsolateScheduler::workerLoop() {
+    Isolate isolate;
+    for (;;) {
+        std::packaged_task<ScriptResult(Isolate&)> job;
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            available.wait(lock, [this] { return stopping || !jobs.empty(); });
+            // Drain the queue before stopping so no submitted future is
+            // left without a result.
+            if (jobs.empty()) return;
+            job = std::move(jobs.front());
+            jobs.pop_front();
+        }
+        job(isolate);
+    }
+}
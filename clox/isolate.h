@@ -0,0 +1,82 @@
+#ifndef CLOX_ISOLATE_H
+#define CLOX_ISOLATE_H
+
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <future>
+#include <mutex>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+#include "memory.h"
+#include "scanner.h"
+#include "table.h"
+#include "value.h"
+
+struct ScriptResult {
+    int tokens = 0;
+    int functions = 0;
+    int globals = 0;
+    bool ok = true;
+    std::string diagnostics;
+};
+
+// Everything one script needs to run, owned by one thread at a time: its
+// scanner, heap, globals and value stack. Isolates share nothing mutable;
+// the only shared data is read-only (DFA tables, keyword lookup, Unicode
+// tables).
+//
+// There is no bytecode VM yet, so run() performs the load phase of a
+// script: scan it, index its functions and bind each top-level function to
+// a global ObjFunction in this isolate's heap.
+class Isolate
+{
+private:
+    BasicScanner<IndexedScan> scanner;
+    std::ostringstream diagnostics;
+    Heap heap;
+    Table globals;
+    std::vector<Value> stack;
+
+public:
+    explicit Isolate(HeapOptions options = HeapOptions());
+    Isolate(const Isolate&) = delete;
+    Isolate& operator=(const Isolate&) = delete;
+
+    // Runs a script after discarding the previous script's globals and
+    // stack. Buffers and arenas are kept for the next script.
+    ScriptResult run(const std::string& source);
+    void reset();
+
+    Heap& objectHeap() { return heap; }
+    const Table& globalTable() const { return globals; }
+};
+
+// Runs scripts on a fixed pool of threads. Each worker owns one Isolate and
+// reuses it for every script it picks up, so the only synchronization is
+// the job queue.
+class IsolateScheduler
+{
+private:
+    std::vector<std::thread> workers;
+    std::deque<std::packaged_task<ScriptResult(Isolate&)>> jobs;
+    std::mutex mutex;
+    std::condition_variable available;
+    bool stopping = false;
+
+    void workerLoop();
+
+public:
+    // 0 means one worker per hardware thread.
+    explicit IsolateScheduler(unsigned threads = 0);
+    ~IsolateScheduler();
+    IsolateScheduler(const IsolateScheduler&) = delete;
+    IsolateScheduler& operator=(const IsolateScheduler&) = delete;
+
+    std::future<ScriptResult> submit(std::string source);
+    unsigned threadCount() const { return static_cast<unsigned>(workers.size()); }
+};
+
+#endif
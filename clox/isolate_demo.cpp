@@ -0,0 +1,72 @@
+#include <chrono>
+#include <iostream>
+#include <string>
+#include <vector>
+#include "isolate.h"
+
+static std::string makeScript(int seed) {
+    std::string script;
+    for (int i = 0; i < 40; i++) {
+        std::string n = std::to_string(seed * 100 + i);
+        script += "fun f" + n + "(a, b) { var t = a + b * " + n + "; if (t > 10) { print t; } return t; }\n";
+    }
+    script += "print f" + std::to_string(seed * 100) + "(1, 2);\n";
+    return script;
+}
+
+static double runBatch(unsigned threads, const std::vector<std::string>& scripts) {
+    IsolateScheduler scheduler(threads);
+    auto begin = std::chrono::steady_clock::now();
+    std::vector<std::future<ScriptResult>> results;
+    results.reserve(scripts.size());
+    for (const std::string& script : scripts) results.push_back(scheduler.submit(script));
+    for (auto& result : results) result.get();
+    auto end = std::chrono::steady_clock::now();
+    return scripts.size() / std::chrono::duration<double>(end - begin).count();
+}
+
+int main() {
+    std::cout << "=== Isolate Test ===" << std::endl << std::endl;
+
+    // Test 1
+    std::cout << "Test 1: One isolate, reused" << std::endl;
+    Isolate isolate;
+    ScriptResult first = isolate.run("fun add(a, b) { return a + b; }\nfun neg(x) { return -x; }\nprint add(1, 2);");
+    std::cout << "tokens: " << first.tokens << ", functions: " << first.functions
+              << ", globals: " << first.globals << ", ok: " << first.ok << '\n';
+    ScriptResult second = isolate.run("fun broken() { print (1; }\n@");
+    std::cout << "tokens: " << second.tokens << ", functions: " << second.functions
+              << ", globals: " << second.globals << ", ok: " << second.ok << '\n';
+    std::cout << "diagnostics:\n" << second.diagnostics;
+    // A function declared in a block is local to it, not a global.
+    ScriptResult third = isolate.run("{ fun local() {} }");
+    std::cout << "tokens: " << third.tokens << ", functions: " << third.functions
+              << ", globals: " << third.globals << ", ok: " << third.ok << '\n';
+    std::cout << std::endl;
+
+    // Test 2
+    std::cout << "Test 2: Scheduler results" << std::endl;
+    {
+        IsolateScheduler scheduler(4);
+        std::vector<std::future<ScriptResult>> results;
+        for (int i = 0; i < 8; i++) results.push_back(scheduler.submit(makeScript(i)));
+        int functions = 0;
+        for (auto& result : results) functions += result.get().functions;
+        std::cout << "Functions across 8 scripts: " << functions << std::endl;
+    }
+    std::cout << std::endl;
+
+    // Test 3
+    std::cout << "Test 3: Throughput by thread count" << std::endl;
+    std::vector<std::string> scripts;
+    for (int i = 0; i < 4000; i++) scripts.push_back(makeScript(i));
+    double baseline = runBatch(1, scripts);
+    unsigned hardware = std::thread::hardware_concurrency();
+    for (unsigned threads = 1; threads <= (hardware == 0 ? 1 : hardware); threads *= 2) {
+        double rate = threads == 1 ? baseline : runBatch(threads, scripts);
+        std::cout << threads << " thread(s): " << static_cast<long>(rate) << " scripts/s ("
+                  << rate / baseline << "x)\n";
+    }
+
+    return 0;
+}
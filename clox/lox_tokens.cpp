@@ -0,0 +1,279 @@
+// lox-tokens: dumps the token stream of a Lox source file.
+//
+// Usage: lox-tokens [--scanner=hand|table] [--format=text|jsonl|binary]
+//                   [-o <output>] <file|->
+//
+// Formats:
+//   text    "TYPE lexeme line" per token, same as Token::toString().
+//   jsonl   {"type":"TYPE","lexeme":"...","line":N} per token.
+//   binary  One record per token, little-endian:
+//           u8 type, u32 line, u32 lexeme length, lexeme bytes.
+//
+// Input is read and scanned a block at a time, so memory use grows with the
+// longest lexeme rather than the file, and pipes work as input ("-" reads
+// stdin). Output goes through a large buffer that is only flushed when
+// full, so dumping multi-GB corpora is not bound by per-line writes.
+#include <algorithm>
+#include <charconv>
+#include <cstdint>
+#include <cstdio>
+#include <iostream>
+#include <string>
+#include <string_view>
+#include <vector>
+#include "scanner.h"
+#include "scanner_table.h"
+
+enum OutputFormat { FORMAT_TEXT, FORMAT_JSONL, FORMAT_BINARY };
+enum ScannerKind { SCANNER_HAND, SCANNER_TABLE };
+
+class BufferedWriter {
+private:
+    static constexpr size_t BUFFER_SIZE = 1 << 20;
+
+    FILE* out;
+    std::vector<char> buffer;
+    size_t used = 0;
+    bool failed = false;
+
+public:
+    explicit BufferedWriter(FILE* out) : out(out), buffer(BUFFER_SIZE) {}
+    ~BufferedWriter() { flush(); }
+
+    void flush() {
+        if (used > 0 && fwrite(buffer.data(), 1, used, out) != used) failed = true;
+        used = 0;
+    }
+
+    bool ok() const { return !failed; }
+
+    void put(char c) {
+        if (used == BUFFER_SIZE) flush();
+        buffer[used++] = c;
+    }
+
+    void write(std::string_view text) {
+        if (text.size() > BUFFER_SIZE - used) {
+            flush();
+            // Lexemes larger than the whole buffer go straight to the file.
+            if (text.size() > BUFFER_SIZE) {
+                if (fwrite(text.data(), 1, text.size(), out) != text.size()) failed = true;
+                return;
+            }
+        }
+        text.copy(buffer.data() + used, text.size());
+        used += text.size();
+    }
+
+    void writeDecimal(int value) {
+        char digits[16];
+        auto result = std::to_chars(digits, digits + sizeof(digits), value);
+        write(std::string_view(digits, result.ptr - digits));
+    }
+
+    void writeU32(uint32_t value) {
+        char bytes[4] = {
+            static_cast<char>(value & 0xff),
+            static_cast<char>((value >> 8) & 0xff),
+            static_cast<char>((value >> 16) & 0xff),
+            static_cast<char>((value >> 24) & 0xff)
+        };
+        write(std::string_view(bytes, sizeof(bytes)));
+    }
+};
+
+static void writeJsonString(BufferedWriter& writer, std::string_view text) {
+    static const char hex[] = "0123456789abcdef";
+    writer.put('"');
+    size_t runStart = 0;
+    for (size_t i = 0; i < text.size(); i++) {
+        unsigned char c = static_cast<unsigned char>(text[i]);
+        if (c >= 0x20 && c != '"' && c != '\\') continue;
+
+        writer.write(text.substr(runStart, i - runStart));
+        runStart = i + 1;
+        switch (c) {
+            case '"': writer.write("\\\""); break;
+            case '\\': writer.write("\\\\"); break;
+            case '\n': writer.write("\\n"); break;
+            case '\r': writer.write("\\r"); break;
+            case '\t': writer.write("\\t"); break;
+            default:
+                writer.write("\\u00");
+                writer.put(hex[c >> 4]);
+                writer.put(hex[c & 0xf]);
+                break;
+        }
+    }
+    writer.write(text.substr(runStart));
+    writer.put('"');
+}
+
+static void writeToken(BufferedWriter& writer, const Token& token, OutputFormat format) {
+    switch (format) {
+        case FORMAT_TEXT:
+            writer.write(tokenTypeName(token.type));
+            writer.put(' ');
+            writer.write(token.lexeme);
+            writer.put(' ');
+            writer.writeDecimal(token.line);
+            writer.put('\n');
+            break;
+        case FORMAT_JSONL:
+            writer.write("{\"type\":\"");
+            writer.write(tokenTypeName(token.type));
+            writer.write("\",\"lexeme\":");
+            writeJsonString(writer, token.lexeme);
+            writer.write(",\"line\":");
+            writer.writeDecimal(token.line);
+            writer.write("}\n");
+            break;
+        case FORMAT_BINARY:
+            writer.put(static_cast<char>(token.type));
+            writer.writeU32(static_cast<uint32_t>(token.line));
+            writer.writeU32(static_cast<uint32_t>(token.lexeme.size()));
+            writer.write(token.lexeme);
+            break;
+    }
+}
+
+// Scans `in` one block at a time. A piece handed to the scanner ends after
+// its last newline, or wherever it reaches MAX_PIECE on a long line; the
+// scanner leaves any lexeme that might continue past the cut for the next
+// piece. Each byte is searched for a cut once, and a string literal left
+// open is only rescanned once its closing quote has been read, so the work
+// stays linear in the input.
+template <typename ScannerType>
+static bool dumpTokens(FILE* in, BufferedWriter& writer, OutputFormat format) {
+    static constexpr size_t INPUT_BLOCK = 1 << 20;
+    // The tokens of a piece are held at once, several times its size.
+    static constexpr size_t MAX_PIECE = INPUT_BLOCK;
+
+    ScannerType scanner;
+    std::vector<char> block(INPUT_BLOCK);
+    std::string pending;
+    // Bytes of pending already searched for a cut.
+    size_t searched = 0;
+    // Whether pending starts with a string literal still waiting for its
+    // closing quote.
+    bool openLiteral = false;
+    // A piece the scanner made no progress on (one lexeme filling all of
+    // it) is retried only once twice as much input is in.
+    size_t minimumPiece = 0;
+    int line = 1;
+    for (;;) {
+        size_t read = fread(block.data(), 1, block.size(), in);
+        pending.append(block.data(), read);
+        bool last = read < block.size();
+        if (last && ferror(in)) return false;
+
+        size_t end = pending.size();
+        if (!last) {
+            if (openLiteral) {
+                size_t close = pending.find('"', std::max<size_t>(searched, 1));
+                if (close == std::string::npos) {
+                    searched = pending.size();
+                    continue;
+                }
+                openLiteral = false;
+                searched = close + 1;
+            }
+            size_t newline = std::string_view(pending).substr(searched).rfind('\n');
+            if (newline != std::string::npos && searched + newline + 1 >= minimumPiece) {
+                end = searched + newline + 1;
+            } else if (pending.size() < std::max(MAX_PIECE, minimumPiece)) {
+                searched = pending.size();
+                continue;
+            }
+        }
+        scanner.reset(std::string_view(pending).substr(0, end));
+        for (const Token& token : scanner.scanChunk(line, last)) writeToken(writer, token, format);
+        if (last) return true;
+
+        size_t consumed = scanner.resumeOffset();
+        line = scanner.resumeLine();
+        minimumPiece = consumed == 0 ? 2 * end : 0;
+        pending.erase(0, consumed);
+        // The scanned part of what is left holds no cut.
+        searched = end - consumed;
+        openLiteral = consumed < end && pending[0] == '"' &&
+            std::string_view(pending).substr(1, searched - 1).find('"') == std::string_view::npos;
+    }
+}
+
+static void usage() {
+    std::cerr << "Usage: lox-tokens [--scanner=hand|table] [--format=text|jsonl|binary] "
+                 "[-o <output>] <file|->" << std::endl;
+}
+
+int main(int argc, char* argv[]) {
+    ScannerKind scannerKind = SCANNER_HAND;
+    OutputFormat format = FORMAT_TEXT;
+    const char* inputPath = nullptr;
+    const char* outputPath = nullptr;
+
+    for (int i = 1; i < argc; i++) {
+        std::string_view arg = argv[i];
+        if (arg == "--scanner=hand") scannerKind = SCANNER_HAND;
+        else if (arg == "--scanner=table") scannerKind = SCANNER_TABLE;
+        else if (arg == "--format=text") format = FORMAT_TEXT;
+        else if (arg == "--format=jsonl") format = FORMAT_JSONL;
+        else if (arg == "--format=binary") format = FORMAT_BINARY;
+        else if (arg == "-o" && i + 1 < argc) outputPath = argv[++i];
+        else if ((arg == "-" || (!arg.empty() && arg[0] != '-')) && inputPath == nullptr) {
+            inputPath = argv[i];
+        }
+        else {
+            usage();
+            return 64;
+        }
+    }
+    if (inputPath == nullptr) {
+        usage();
+        return 64;
+    }
+
+    FILE* in = stdin;
+    if (std::string_view(inputPath) != "-") {
+        in = fopen(inputPath, "rb");
+        if (in == nullptr) {
+            std::cerr << "Could not read file \"" << inputPath << "\"." << std::endl;
+            return 74;
+        }
+    }
+
+    FILE* out = stdout;
+    if (outputPath != nullptr) {
+        out = fopen(outputPath, "wb");
+        if (out == nullptr) {
+            std::cerr << "Could not open \"" << outputPath << "\" for writing." << std::endl;
+            return 74;
+        }
+    }
+
+    bool ok;
+    bool readOk;
+    {
+        BufferedWriter writer(out);
+        if (scannerKind == SCANNER_HAND) {
+            readOk = dumpTokens<Scanner>(in, writer, format);
+        } else {
+            readOk = dumpTokens<TableDrivenScanner>(in, writer, format);
+        }
+        writer.flush();
+        ok = writer.ok();
+    }
+    if (in != stdin) fclose(in);
+    if (!readOk) {
+        std::cerr << "Could not read file \"" << inputPath << "\"." << std::endl;
+        return 74;
+    }
+
+    if (out != stdout) ok = (fclose(out) == 0) && ok;
+    else ok = (fflush(out) == 0) && ok;
+    if (!ok) {
+        std::cerr << "Error writing token output." << std::endl;
+        return 74;
+    }
+    return 0;
+}
@@ -0,0 +1,274 @@
+#include <chrono>
+#include <cstring>
+#include <iostream>
+#include <new>
+#include "memory.h"
+
+static double now() {
+    using namespace std::chrono;
+    return duration<double>(steady_clock::now().time_since_epoch()).count();
+}
+
+static size_t roundToClass(size_t size, size_t classBytes) {
+    return (size + classBytes - 1) / classBytes * classBytes;
+}
+
+static size_t tableBytes(const Table& table) {
+    return static_cast<size_t>(table.capacity()) * sizeof(Table::Entry);
+}
+
+Heap::Heap(HeapOptions options)
+    : options(options), createdAt(now()), nextGC(options.initialThreshold) {}
+
+Heap::~Heap() {
+    Obj* object = objects;
+    while (object != nullptr) {
+        Obj* next = object->next;
+        if (object->type == OBJ_INSTANCE) {
+            reinterpret_cast<ObjInstance*>(object)->~ObjInstance();
+        }
+        if (object->size > MAX_SMALL_SIZE) ::operator delete(object);
+        object = next;
+    }
+    for (char* arena : arenas) ::operator delete(arena);
+}
+
+void* Heap::allocateBlock(size_t size) {
+    if (size > MAX_SMALL_SIZE) return ::operator new(size);
+
+    FreeBlock*& freeList = freeLists[size / SIZE_CLASS_BYTES - 1];
+    if (freeList != nullptr) {
+        FreeBlock* block = freeList;
+        freeList = block->next;
+        return block;
+    }
+
+    if (bump == nullptr || static_cast<size_t>(arenaEnd - bump) < size) {
+        // The tail of the old arena is too small for this block; it stays
+        // unused rather than being split into free lists.
+        char* arena = static_cast<char*>(::operator new(ARENA_SIZE));
+        arenas.push_back(arena);
+        statistics.arenaBytes += ARENA_SIZE;
+        bump = arena;
+        arenaEnd = arena + ARENA_SIZE;
+    }
+    void* block = bump;
+    bump += size;
+    return block;
+}
+
+Obj* Heap::allocateObject(size_t size, ObjType type) {
+    size = size > MAX_SMALL_SIZE ? size : roundToClass(size, SIZE_CLASS_BYTES);
+    if (options.stressGC || statistics.liveBytes + size > nextGC) {
+        collectGarbage();
+    }
+
+    Obj* object = static_cast<Obj*>(allocateBlock(size));
+    object->type = type;
+    object->isMarked = false;
+    object->size = static_cast<uint32_t>(size);
+    object->next = objects;
+    objects = object;
+
+    statistics.liveBytes += size;
+    statistics.totalAllocated += size;
+    return object;
+}
+
+void Heap::freeObject(Obj* object) {
+    if (object->type == OBJ_INSTANCE) {
+        ObjInstance* instance = reinterpret_cast<ObjInstance*>(object);
+        statistics.liveBytes -= instance->fieldBytes;
+        instance->~ObjInstance();
+    }
+    size_t size = object->size;
+    statistics.liveBytes -= size;
+    statistics.objectsFreed++;
+
+    if (size > MAX_SMALL_SIZE) {
+        ::operator delete(object);
+        return;
+    }
+    FreeBlock* block = reinterpret_cast<FreeBlock*>(object);
+    FreeBlock*& freeList = freeLists[size / SIZE_CLASS_BYTES - 1];
+    block->next = freeList;
+    freeList = block;
+}
+
+ObjString* Heap::intern(std::string_view text) {
+    int length = static_cast<int>(text.size());
+    uint32_t hash = hashString(text.data(), length);
+    ObjString* interned = strings.findString(text.data(), length, hash);
+    if (interned != nullptr) return interned;
+
+    ObjString* string = reinterpret_cast<ObjString*>(
+        allocateObject(sizeof(ObjString) + length + 1, OBJ_STRING));
+    string->length = length;
+    string->hash = hash;
+    memcpy(string->chars(), text.data(), length);
+    string->chars()[length] = '\0';
+
+    strings.set(string, Value::nil());
+    return string;
+}
+
+ObjFunction* Heap::newFunction(ObjString* name, int arity, int upvalueCount) {
+    // `name` must survive the allocation below.
+    pushRoot(Value::object(reinterpret_cast<Obj*>(name)));
+    ObjFunction* function = reinterpret_cast<ObjFunction*>(
+        allocateObject(sizeof(ObjFunction), OBJ_FUNCTION));
+    popRoot();
+    function->arity = arity;
+    function->upvalueCount = upvalueCount;
+    function->name = name;
+    function->bodyStart = -1;
+    function->bodyEnd = -1;
+    return function;
+}
+
+ObjClosure* Heap::newClosure(ObjFunction* function) {
+    int upvalueCount = function->upvalueCount;
+    pushRoot(Value::object(&function->obj));
+    ObjClosure* closure = reinterpret_cast<ObjClosure*>(
+        allocateObject(sizeof(ObjClosure) + sizeof(Value) * upvalueCount, OBJ_CLOSURE));
+    popRoot();
+    closure->function = function;
+    closure->upvalueCount = upvalueCount;
+    for (int i = 0; i < upvalueCount; i++) closure->upvalues()[i] = Value::nil();
+    return closure;
+}
+
+ObjInstance* Heap::newInstance(ObjString* className) {
+    pushRoot(Value::object(&className->obj));
+    Obj* object = allocateObject(sizeof(ObjInstance), OBJ_INSTANCE);
+    popRoot();
+    ObjInstance* instance = reinterpret_cast<ObjInstance*>(object);
+    new (&instance->fields) Table();
+    instance->className = className;
+    instance->fieldBytes = 0;
+    return instance;
+}
+
+bool Heap::setField(ObjInstance* instance, ObjString* name, Value value) {
+    bool isNewField = instance->fields.set(name, value);
+    size_t bytes = tableBytes(instance->fields);
+    if (bytes != instance->fieldBytes) {
+        // Tables only grow, so this is the size of the new entry array.
+        size_t grown = bytes - instance->fieldBytes;
+        statistics.liveBytes += grown;
+        statistics.totalAllocated += grown;
+        instance->fieldBytes = bytes;
+    }
+    return isNewField;
+}
+
+void Heap::markObject(Obj* object) {
+    if (object == nullptr || object->isMarked) return;
+    object->isMarked = true;
+    // Strings have no references, so they never need to be traced.
+    if (object->type != OBJ_STRING) grayStack.push_back(object);
+}
+
+void Heap::markValue(Value value) {
+    if (value.isObj()) markObject(value.as.obj);
+}
+
+void Heap::markTable(const Table& table) {
+    for (int i = 0; i < table.capacity(); i++) {
+        const Table::Entry& entry = table.entryAt(i);
+        if (entry.key == nullptr) continue;
+        markObject(&entry.key->obj);
+        markValue(entry.value);
+    }
+}
+
+void Heap::blackenObject(Obj* object) {
+    switch (object->type) {
+        case OBJ_STRING:
+            break;
+        case OBJ_FUNCTION: {
+            ObjFunction* function = reinterpret_cast<ObjFunction*>(object);
+            if (function->name != nullptr) markObject(&function->name->obj);
+            break;
+        }
+        case OBJ_CLOSURE: {
+            ObjClosure* closure = reinterpret_cast<ObjClosure*>(object);
+            markObject(&closure->function->obj);
+            for (int i = 0; i < closure->upvalueCount; i++) markValue(closure->upvalues()[i]);
+            break;
+        }
+        case OBJ_INSTANCE: {
+            ObjInstance* instance = reinterpret_cast<ObjInstance*>(object);
+            markObject(&instance->className->obj);
+            markTable(instance->fields);
+            break;
+        }
+    }
+}
+
+void Heap::traceReferences() {
+    while (!grayStack.empty()) {
+        Obj* object = grayStack.back();
+        grayStack.pop_back();
+        blackenObject(object);
+    }
+}
+
+void Heap::sweep() {
+    Obj* previous = nullptr;
+    Obj* object = objects;
+    while (object != nullptr) {
+        if (object->isMarked) {
+            object->isMarked = false;
+            previous = object;
+            object = object->next;
+            continue;
+        }
+        Obj* unreached = object;
+        object = object->next;
+        if (previous != nullptr) previous->next = object;
+        else objects = object;
+        freeObject(unreached);
+    }
+}
+
+void Heap::collectGarbage() {
+    double start = now();
+    size_t before = statistics.liveBytes;
+
+    for (Value value : tempRoots) markValue(value);
+    if (rootMarker) rootMarker(*this);
+    traceReferences();
+    strings.removeUnmarked();
+    sweep();
+
+    size_t grown = static_cast<size_t>(statistics.liveBytes * options.growthFactor);
+    nextGC = grown > options.initialThreshold ? grown : options.initialThreshold;
+
+    double pause = now() - start;
+    statistics.collections++;
+    statistics.totalPauseSeconds += pause;
+    if (pause > statistics.maxPauseSeconds) statistics.maxPauseSeconds = pause;
+
+    if (options.logGC) {
+        std::cerr << "-- gc collected " << before - statistics.liveBytes << " bytes (from "
+                  << before << " to " << statistics.liveBytes << ") next at " << nextGC
+                  << ", pause " << pause * 1e6 << " us" << std::endl;
+    }
+}
+
+const HeapStats& Heap::stats() {
+    statistics.elapsedSeconds = now() - createdAt;
+    return statistics;
+}
+
+void Heap::printStats(std::ostream& out) {
+    const HeapStats& s = stats();
+    out << "bytes allocated: " << s.totalAllocated << '\n'
+        << "live bytes: " << s.liveBytes << '\n'
+        << "arena bytes: " << s.arenaBytes << '\n'
+        << "collections: " << s.collections << " (" << s.collectionsPerSecond() << "/s)\n"
+        << "objects freed: " << s.objectsFreed << '\n'
+        << "total pause: " << s.totalPauseSeconds * 1e3 << " ms\n"
+        << "max pause: " << s.maxPauseSeconds * 1e3 << " ms\n";
+}
@@ -0,0 +1,115 @@
+#ifndef CLOX_MEMORY_H
+#define CLOX_MEMORY_H
+
+#include <cstddef>
+#include <functional>
+#include <iosfwd>
+#include <string_view>
+#include <vector>
+#include "object.h"
+#include "table.h"
+#include "value.h"
+
+struct HeapOptions {
+    // After a collection the next one runs once live bytes reach
+    // liveBytes * growthFactor (but never below initialThreshold).
+    double growthFactor = 2.0;
+    size_t initialThreshold = 1024 * 1024;
+    // Collect before every allocation, to shake out missing roots.
+    bool stressGC = false;
+    // Print a line per collection to stderr.
+    bool logGC = false;
+};
+
+struct HeapStats {
+    size_t totalAllocated = 0;  // bytes handed out over the heap's lifetime
+    size_t liveBytes = 0;       // bytes in objects not yet freed
+    size_t arenaBytes = 0;      // bytes reserved from the system for arenas
+    size_t collections = 0;
+    size_t objectsFreed = 0;
+    double totalPauseSeconds = 0;
+    double maxPauseSeconds = 0;
+    double elapsedSeconds = 0;  // since the heap was created
+
+    double collectionsPerSecond() const {
+        return elapsedSeconds > 0 ? collections / elapsedSeconds : 0;
+    }
+};
+
+// Object heap for runtime strings, functions, closures and instances.
+//
+// Small objects are bump-allocated from fixed-size arenas; the sweeper
+// threads freed blocks onto per-size-class free lists that later
+// allocations reuse first, so a steady workload stops growing the arenas.
+// Large objects go straight to the system allocator.
+//
+// Collection is precise mark-sweep. Roots are the values pushed with
+// pushRoot() plus whatever the root marker (set by the VM) marks. The
+// string table is weak: strings only it references are freed.
+class Heap
+{
+private:
+    static constexpr size_t ARENA_SIZE = 256 * 1024;
+    static constexpr size_t SIZE_CLASS_BYTES = 16;
+    static constexpr size_t MAX_SMALL_SIZE = 512;
+    static constexpr size_t NUM_SIZE_CLASSES = MAX_SMALL_SIZE / SIZE_CLASS_BYTES;
+
+    struct FreeBlock {
+        FreeBlock* next;
+    };
+
+    HeapOptions options;
+    HeapStats statistics;
+    double createdAt;
+
+    std::vector<char*> arenas;
+    char* bump = nullptr;
+    char* arenaEnd = nullptr;
+    FreeBlock* freeLists[NUM_SIZE_CLASSES] = {};
+
+    Obj* objects = nullptr;
+    size_t nextGC;
+    Table strings;
+    std::vector<Value> tempRoots;
+    std::vector<Obj*> grayStack;
+    std::function<void(Heap&)> rootMarker;
+
+    Obj* allocateObject(size_t size, ObjType type);
+    void* allocateBlock(size_t size);
+    void freeObject(Obj* object);
+    void blackenObject(Obj* object);
+    void traceReferences();
+    void sweep();
+
+public:
+    explicit Heap(HeapOptions options = HeapOptions());
+    ~Heap();
+    Heap(const Heap&) = delete;
+    Heap& operator=(const Heap&) = delete;
+
+    // Returns the single ObjString for this character sequence.
+    ObjString* intern(std::string_view text);
+    ObjFunction* newFunction(ObjString* name, int arity, int upvalueCount);
+    ObjClosure* newClosure(ObjFunction* function);
+    ObjInstance* newInstance(ObjString* className);
+    // Sets a field and charges any growth of the field table to live bytes,
+    // so field-heavy workloads pace the collector. Existing fields can also
+    // be updated in place, e.g. with Table::setCached.
+    bool setField(ObjInstance* instance, ObjString* name, Value value);
+
+    // Keeps a value alive while native code holds it between allocations.
+    void pushRoot(Value value) { tempRoots.push_back(value); }
+    void popRoot() { tempRoots.pop_back(); }
+    void setRootMarker(std::function<void(Heap&)> marker) { rootMarker = std::move(marker); }
+
+    void markValue(Value value);
+    void markObject(Obj* object);
+    void markTable(const Table& table);
+
+    void collectGarbage();
+    const HeapStats& stats();
+    void printStats(std::ostream& out);
+    int internedStrings() const { return strings.size(); }
+};
+
+#endif
@@ -0,0 +1,11 @@
+#include "object.h"
+
+uint32_t hashString(const char* chars, int length) {
+    // FNV-1a
+    uint32_t hash = 2166136261u;
+    for (int i = 0; i < length; i++) {
+        hash ^= static_cast<uint8_t>(chars[i]);
+        hash *= 16777619;
+    }
+    return hash;
+}
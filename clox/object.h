@@ -0,0 +1,71 @@
+#ifndef CLOX_OBJECT_H
+#define CLOX_OBJECT_H
+
+#include <cstdint>
+#include <string_view>
+#include "table.h"
+#include "value.h"
+
+enum ObjType {
+    OBJ_STRING,
+    OBJ_FUNCTION,
+    OBJ_CLOSURE,
+    OBJ_INSTANCE
+};
+
+// Header shared by every heap object. `size` is the full allocation size,
+// which the sweeper needs to return the block to the right free list.
+struct Obj {
+    ObjType type;
+    bool isMarked;
+    uint32_t size;
+    Obj* next;
+};
+
+// Immutable, interned string. The characters are stored inline right after
+// the header, so a string is a single allocation; the hash is computed once.
+struct ObjString {
+    Obj obj;
+    int length;
+    uint32_t hash;
+
+    const char* chars() const { return reinterpret_cast<const char*>(this + 1); }
+    char* chars() { return reinterpret_cast<char*>(this + 1); }
+    std::string_view view() const { return std::string_view(chars(), length); }
+};
+
+// A function declaration. Until there is a bytecode compiler the body is
+// identified by its token range (see function_index.h).
+struct ObjFunction {
+    Obj obj;
+    int arity;
+    int upvalueCount;
+    ObjString* name;
+    int bodyStart;
+    int bodyEnd;
+};
+
+// A function plus its captured variables, stored inline after the header.
+struct ObjClosure {
+    Obj obj;
+    ObjFunction* function;
+    int upvalueCount;
+
+    Value* upvalues() { return reinterpret_cast<Value*>(this + 1); }
+};
+
+struct ObjInstance {
+    Obj obj;
+    ObjString* className;
+    // Add fields with Heap::setField so their storage is accounted for.
+    Table fields;
+    size_t fieldBytes;      // field storage charged to the heap's live bytes
+};
+
+inline bool isObjType(Value value, ObjType type) {
+    return value.isObj() && value.as.obj->type == type;
+}
+
+uint32_t hashString(const char* chars, int length);
+
+#endif
@@ -0,0 +1,230 @@
+#include <algorithm>
+#include <cerrno>
+#include <iomanip>
+#include <map>
+#include <mutex>
+#include <ostream>
+#include <string>
+#include <sys/syscall.h>
+#include <unistd.h>
+#include <utility>
+#include <vector>
+#include "profiler.h"
+
+// glibc only names the thread-id member of sigevent in the kernel headers.
+#ifndef sigev_notify_thread_id
+#define sigev_notify_thread_id _sigev_un._tid
+#endif
+
+// The profiler started on this thread, if any. The timer signals only the
+// thread it was created for, so the handler finds its profiler here.
+static thread_local Profiler* threadProfiler = nullptr;
+
+// The SIGPROF handler is process-wide; it is installed while any profiler
+// is running and the previous one is restored after the last stops.
+static std::mutex handlerMutex;
+static int handlerUsers = 0;
+static struct sigaction previousAction;
+
+static bool acquireHandler(void (*handler)(int)) {
+    std::lock_guard<std::mutex> lock(handlerMutex);
+    if (handlerUsers == 0) {
+        struct sigaction action = {};
+        action.sa_handler = handler;
+        action.sa_flags = SA_RESTART;
+        sigemptyset(&action.sa_mask);
+        if (sigaction(SIGPROF, &action, &previousAction) != 0) return false;
+    }
+    handlerUsers++;
+    return true;
+}
+
+static void releaseHandler() {
+    std::lock_guard<std::mutex> lock(handlerMutex);
+    if (--handlerUsers == 0) sigaction(SIGPROF, &previousAction, nullptr);
+}
+
+Profiler::Profiler(Options options) : options(options) {
+    // Room for at least one full-depth sample; whole records only.
+    size_t minimum = recordSize(ExecutionState::MAX_FRAMES);
+    capacity = std::max(options.bufferBytes, minimum) / alignof(SampledFrame) * alignof(SampledFrame);
+    // Left uninitialized, so untouched pages cost no memory.
+    buffer.reset(new char[capacity]);
+}
+
+Profiler::~Profiler() {
+    stop();
+}
+
+void Profiler::handleSignal(int) {
+    int savedErrno = errno;
+    Profiler* profiler = threadProfiler;
+    if (profiler != nullptr && profiler->target != nullptr) {
+        profiler->sample(*profiler->target);
+    }
+    errno = savedErrno;
+}
+
+bool Profiler::start(ExecutionState& state) {
+    if (timerRunning || threadProfiler != nullptr) return false;
+    if (!acquireHandler(handleSignal)) return false;
+    target = &state;
+    threadSlot = &threadProfiler;
+    threadProfiler = this;
+
+    struct sigevent event = {};
+    event.sigev_notify = SIGEV_THREAD_ID;
+    event.sigev_signo = SIGPROF;
+    event.sigev_notify_thread_id = static_cast<pid_t>(syscall(SYS_gettid));
+    if (timer_create(CLOCK_THREAD_CPUTIME_ID, &event, &timer) != 0) {
+        threadProfiler = nullptr;
+        releaseHandler();
+        return false;
+    }
+
+    struct itimerspec interval = {};
+    interval.it_interval.tv_sec = options.intervalMicros / 1000000;
+    interval.it_interval.tv_nsec = (options.intervalMicros % 1000000) * 1000L;
+    interval.it_value = interval.it_interval;
+    if (timer_settime(timer, 0, &interval, nullptr) != 0) {
+        timer_delete(timer);
+        threadProfiler = nullptr;
+        releaseHandler();
+        return false;
+    }
+    timerRunning = true;
+    return true;
+}
+
+void Profiler::stop() {
+    if (!timerRunning) return;
+    timer_delete(timer);
+    *threadSlot = nullptr;
+    releaseHandler();
+    timerRunning = false;
+}
+
+void Profiler::evictOldest() {
+    size_t offset = readPosition % capacity;
+    const SampleHeader* header = reinterpret_cast<const SampleHeader*>(buffer.get() + offset);
+    if (capacity - offset < sizeof(SampleHeader) || header->frames == WRAP) {
+        readPosition += capacity - offset;
+        return;
+    }
+    readPosition += recordSize(header->frames);
+    samples--;
+    overwritten++;
+}
+
+void Profiler::sample(const ExecutionState& state) {
+    if (busy) {
+        dropped++;
+        return;
+    }
+    busy = 1;
+
+    uint32_t depth = static_cast<uint32_t>(state.depth);
+    size_t size = recordSize(depth);
+    size_t offset = writePosition % capacity;
+    // Records never straddle the end; the rest of the lap is padding.
+    size_t padding = offset + size > capacity ? capacity - offset : 0;
+    while (capacity - (writePosition - readPosition) < padding + size) {
+        if (readPosition == writePosition) {
+            // Empty: start the record at the beginning of the buffer.
+            writePosition += padding;
+            readPosition = writePosition;
+            offset = 0;
+            padding = 0;
+            break;
+        }
+        evictOldest();
+    }
+    if (padding > 0) {
+        if (padding >= sizeof(SampleHeader)) {
+            reinterpret_cast<SampleHeader*>(buffer.get() + offset)->frames = WRAP;
+        }
+        writePosition += padding;
+        offset = 0;
+    }
+
+    SampleHeader* header = reinterpret_cast<SampleHeader*>(buffer.get() + offset);
+    header->frames = depth;
+    header->truncated = static_cast<uint32_t>(state.truncated);
+    SampledFrame* out = reinterpret_cast<SampledFrame*>(header + 1);
+    for (uint32_t i = 0; i < depth; i++) {
+        const ProfileFrame& frame = state.frames[i];
+        // ip already points past the instruction being executed.
+        int at = static_cast<int>(frame.ip - frame.chunk->bytes()) - 1;
+        out[i] = {frame.function, frame.chunk, at < 0 ? 0 : at};
+    }
+    writePosition += size;
+    samples++;
+    busy = 0;
+}
+
+template <typename Visitor>
+void Profiler::forEachSample(Visitor visit) const {
+    busy = 1;
+    size_t position = readPosition;
+    while (position < writePosition) {
+        size_t offset = position % capacity;
+        const SampleHeader* header = reinterpret_cast<const SampleHeader*>(buffer.get() + offset);
+        if (capacity - offset < sizeof(SampleHeader) || header->frames == WRAP) {
+            position += capacity - offset;
+            continue;
+        }
+        visit(*header, reinterpret_cast<const SampledFrame*>(header + 1));
+        position += recordSize(header->frames);
+    }
+    busy = 0;
+}
+
+void Profiler::writeFlat(std::ostream& out) const {
+    std::map<std::pair<std::string, int>, size_t> counts;
+    forEachSample([&](const SampleHeader& header, const SampledFrame* frames) {
+        if (header.truncated > 0) {
+            // The executing frame was too deep to record.
+            counts[{"[truncated]", 0}]++;
+        } else if (header.frames > 0) {
+            const SampledFrame& top = frames[header.frames - 1];
+            counts[{top.function, top.chunk->getLine(top.offset)}]++;
+        }
+    });
+
+    std::vector<std::pair<size_t, std::pair<std::string, int>>> rows;
+    for (const auto& entry : counts) rows.push_back({entry.second, entry.first});
+    std::sort(rows.begin(), rows.end(), [](const auto& a, const auto& b) {
+        return a.first != b.first ? a.first > b.first : a.second < b.second;
+    });
+
+    std::ios::fmtflags flags = out.flags();
+    std::streamsize precision = out.precision();
+    out << std::fixed << std::setprecision(1);
+    out << "samples  percent  line  function\n";
+    for (const auto& row : rows) {
+        double percent = samples == 0 ? 0 : 100.0 * row.first / samples;
+        out << std::setw(7) << row.first << "  " << std::setw(6) << percent << "%  "
+            << std::setw(4) << row.second.second << "  " << row.second.first << '\n';
+    }
+    out.flags(flags);
+    out.precision(precision);
+}
+
+void Profiler::writeCollapsed(std::ostream& out) const {
+    std::map<std::string, size_t> stacks;
+    forEachSample([&](const SampleHeader& header, const SampledFrame* frames) {
+        if (header.frames == 0) return;
+        std::string stack;
+        for (uint32_t i = 0; i < header.frames; i++) {
+            if (i > 0) stack += ';';
+            stack += frames[i].function;
+            stack += ':';
+            stack += std::to_string(frames[i].chunk->getLine(frames[i].offset));
+        }
+        if (header.truncated > 0) {
+            stack += ";[" + std::to_string(header.truncated) + " frames truncated]";
+        }
+        stacks[stack]++;
+    });
+    for (const auto& entry : stacks) out << entry.first << ' ' << entry.second << '\n';
+}
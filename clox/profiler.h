@@ -0,0 +1,159 @@
+#ifndef CLOX_PROFILER_H
+#define CLOX_PROFILER_H
+
+#include <atomic>
+#include <csignal>
+#include <cstddef>
+#include <cstdint>
+#include <ctime>
+#include <iosfwd>
+#include <memory>
+#include "chunk.h"
+
+// One active call as the interpreter publishes it for the profiler. The
+// interpreter stores the instruction pointer here before executing each
+// instruction; that store is the only per-instruction cost of profiling.
+struct ProfileFrame {
+    const char* function;
+    const Chunk* chunk;
+    const uint8_t* volatile ip;
+};
+
+// The call stack of one interpreter thread, readable from a signal handler
+// on that thread. Function names are stored by pointer and must outlive the
+// profiler.
+//
+// Only the outermost MAX_FRAMES calls are recorded. Deeper calls are just
+// counted in `truncated`; while there are any, top() is a scratch frame the
+// profiler never reads, so the interpreter can keep publishing its ip.
+struct ExecutionState {
+    static constexpr int MAX_FRAMES = 64;
+
+    ProfileFrame frames[MAX_FRAMES];
+    volatile sig_atomic_t depth = 0;
+    volatile sig_atomic_t truncated = 0;
+    ProfileFrame overflowFrame = {nullptr, nullptr, nullptr};
+    // Instructions left until the next sample in counter mode.
+    int countdown = 0;
+
+    void push(const char* function, const Chunk* chunk) {
+        if (depth == MAX_FRAMES) {
+            truncated = truncated + 1;
+            return;
+        }
+        frames[depth].function = function;
+        frames[depth].chunk = chunk;
+        frames[depth].ip = chunk->bytes();
+        // The handler must never see the new depth before the frame.
+        std::atomic_signal_fence(std::memory_order_release);
+        depth = depth + 1;
+    }
+    void pop() {
+        if (truncated > 0) truncated = truncated - 1;
+        else depth = depth - 1;
+    }
+    ProfileFrame& top() { return truncated > 0 ? overflowFrame : frames[depth - 1]; }
+};
+
+// Sampling profiler that attributes time to source lines.
+//
+// Samples come from either a per-thread CPU-time timer delivering SIGPROF
+// to the profiled thread only (no cooperation from the interpreter beyond
+// publishing its ip) or an instruction counter the interpreter ticks
+// (deterministic, no signals). Each sample copies the published stack into
+// a ring buffer of fixed byte size, allocated up front: a small header
+// followed by that sample's frames. When the buffer is full the oldest
+// samples are overwritten, so the reports cover the most recent window.
+// The handler neither allocates nor locks; chunks' line tables are only
+// consulted when a report is written.
+//
+// A profiler belongs to the thread that runs the ExecutionState: start(),
+// stop() and tick() are called there. Write reports after stop(), or from
+// that thread in counter mode.
+class Profiler
+{
+public:
+    struct Options {
+        size_t bufferBytes = 4 * 1024 * 1024;
+        int intervalMicros = 1000;      // timer mode, in thread CPU time
+        int instructionPeriod = 10000;  // counter mode
+    };
+
+private:
+    struct SampleHeader {
+        uint32_t frames;        // frames stored after the header, or WRAP
+        uint32_t truncated;     // calls below them that were not recorded
+    };
+    struct SampledFrame {
+        const char* function;
+        const Chunk* chunk;
+        int offset;
+    };
+    // Marks the unused tail of the buffer before a record that wrapped.
+    static constexpr uint32_t WRAP = UINT32_MAX;
+
+    Options options;
+    std::unique_ptr<char[]> buffer;
+    size_t capacity;
+    // Positions only grow; the byte offset is position % capacity.
+    size_t readPosition = 0;
+    size_t writePosition = 0;
+    size_t samples = 0;
+    size_t overwritten = 0;
+    size_t dropped = 0;
+    // Set while the buffer is being written or read, so a signal arriving
+    // in the middle drops its sample instead of corrupting the buffer.
+    mutable volatile sig_atomic_t busy = 0;
+
+    ExecutionState* target = nullptr;
+    timer_t timer;
+    bool timerRunning = false;
+    Profiler** threadSlot = nullptr;
+
+    static void handleSignal(int signal);
+    static size_t recordSize(uint32_t frames) {
+        return sizeof(SampleHeader) + frames * sizeof(SampledFrame);
+    }
+    // Calls visit(header, frames) for every stored sample, oldest first.
+    template <typename Visitor>
+    void forEachSample(Visitor visit) const;
+    void evictOldest();
+
+public:
+    explicit Profiler(Options options);
+    Profiler() : Profiler(Options()) {}
+    ~Profiler();
+    Profiler(const Profiler&) = delete;
+    Profiler& operator=(const Profiler&) = delete;
+
+    // Timer mode: samples `state` on every SIGPROF from this thread's CPU
+    // timer. Each thread can have one running profiler; returns false if
+    // this thread already has one or the timer could not be created.
+    bool start(ExecutionState& state);
+    void stop();
+
+    // Counter mode: call once per executed instruction.
+    void tick(ExecutionState& state) {
+        if (--state.countdown <= 0) {
+            state.countdown = options.instructionPeriod;
+            sample(state);
+        }
+    }
+
+    // Records the current stack of `state`. Async-signal-safe.
+    void sample(const ExecutionState& state);
+
+    // Samples currently held, and those lost to a full buffer or to a
+    // sample arriving while another was being written.
+    size_t sampleCount() const { return samples; }
+    size_t overwrittenSamples() const { return overwritten; }
+    size_t droppedSamples() const { return dropped; }
+
+    // Self samples per function and source line, hottest first.
+    void writeFlat(std::ostream& out) const;
+    // One "outer:line;inner:line count" row per distinct stack, the
+    // collapsed format flamegraph.pl and speedscope read.
+    void writeCollapsed(std::ostream& out) const;
+};
+
+#endif
@@ -0,0 +1,215 @@
+#include <functional>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+#include "function_index.h"
+#include "profiler.h"
+#include "scanner.h"
+
+// There is no bytecode compiler yet, so this demo lowers tokens straight
+// into chunks: every token becomes one instruction on that token's line.
+// A NUMBER token costs that many units of work, a call to a declared
+// function pushes a frame, and everything else costs one unit.
+enum DemoOp : uint8_t { OP_WORK, OP_CALL, OP_RETURN };
+
+struct DemoFunction {
+    std::string name;
+    Chunk chunk;
+};
+
+static void lower(const std::vector<Token>& tokens, int first, int last,
+                  const std::unordered_map<std::string, int>& byName,
+                  const std::vector<FunctionRange>& skip, Chunk& chunk) {
+    size_t next = 0;
+    for (int i = first; i < last; i++) {
+        if (next < skip.size() && i == skip[next].nameToken - 1) {
+            i = skip[next++].bodyEnd;
+            continue;
+        }
+        const Token& token = tokens[i];
+        auto callee = byName.find(token.lexeme);
+        if (token.type == IDENTIFIER && callee != byName.end() &&
+            i + 1 < last && tokens[i + 1].type == LEFT_PAREN) {
+            chunk.write(OP_CALL, token.line);
+            chunk.write(static_cast<uint8_t>(callee->second), token.line);
+        } else if (token.type == NUMBER) {
+            chunk.write(OP_WORK, token.line);
+            chunk.write(static_cast<uint8_t>(std::min(std::stoi(token.lexeme), 255)), token.line);
+        } else {
+            chunk.write(OP_WORK, token.line);
+            chunk.write(1, token.line);
+        }
+    }
+    chunk.write(OP_RETURN, last > 0 ? tokens[last - 1].line : 1);
+}
+
+// Stand-in for the VM's dispatch loop. The only profiling hook is keeping
+// frame.ip current; `profiler` is non-null in counter mode.
+static void run(std::vector<DemoFunction>& functions, DemoFunction& script,
+                ExecutionState& state, Profiler* profiler, int unitCost) {
+    volatile uint64_t sink = 0;
+    state.push(script.name.c_str(), &script.chunk);
+    while (state.depth > 0) {
+        ProfileFrame& frame = state.top();
+        uint8_t op = *frame.ip;
+        frame.ip = frame.ip + 1;
+        if (profiler != nullptr) profiler->tick(state);
+        switch (op) {
+            case OP_WORK: {
+                int units = *frame.ip;
+                frame.ip = frame.ip + 1;
+                for (int i = 0; i < units * unitCost; i++) sink = sink + i;
+                break;
+            }
+            case OP_CALL: {
+                DemoFunction& callee = functions[*frame.ip];
+                frame.ip = frame.ip + 1;
+                if (state.depth < ExecutionState::MAX_FRAMES) {
+                    state.push(callee.name.c_str(), &callee.chunk);
+                }
+                break;
+            }
+            case OP_RETURN:
+                state.pop();
+                break;
+        }
+    }
+}
+
+int main() {
+    std::cout << "=== Profiler Test ===" << std::endl << std::endl;
+
+    std::string source =
+        "fun leaf(n) {\n"
+        "  var x = n * 200;\n"
+        "  return x + 1;\n"
+        "}\n"
+        "fun middle(n) {\n"
+        "  var a = leaf(n);\n"
+        "  var b = 50;\n"
+        "  return a + b;\n"
+        "}\n"
+        "middle(1);\n"
+        "leaf(2);\n"
+        "print 10;\n";
+
+    BasicScanner<IndexedScan> scanner(source);
+    const std::vector<Token>& tokens = scanner.scanTokens();
+    int end = static_cast<int>(tokens.size()) - 1; // leave out EOF
+    std::vector<FunctionRange> ranges = indexFunctions(tokens, scanner.bracketIndex(), 0, end);
+
+    std::unordered_map<std::string, int> byName;
+    for (size_t i = 0; i < ranges.size(); i++) byName[ranges[i].name] = static_cast<int>(i);
+    std::vector<DemoFunction> functions(ranges.size());
+    for (size_t i = 0; i < ranges.size(); i++) {
+        functions[i].name = ranges[i].name;
+        lower(tokens, ranges[i].bodyStart + 1, ranges[i].bodyEnd, byName, {}, functions[i].chunk);
+    }
+    DemoFunction script{"<script>", Chunk()};
+    lower(tokens, 0, end, byName, ranges, script.chunk);
+
+    // Test 1
+    std::cout << "Test 1: Line table" << std::endl;
+    const Chunk& leaf = functions[byName["leaf"]].chunk;
+    std::cout << "leaf: " << leaf.size() << " bytes, lines";
+    for (int offset = 0; offset < leaf.size(); offset += 2) std::cout << ' ' << leaf.getLine(offset);
+    std::cout << std::endl << std::endl;
+
+    // Test 2
+    std::cout << "Test 2: Counter mode (every 7 instructions)" << std::endl;
+    Profiler::Options counterOptions;
+    counterOptions.instructionPeriod = 7;
+    Profiler counter(counterOptions);
+    ExecutionState counterState;
+    counterState.countdown = counterOptions.instructionPeriod;
+    for (int i = 0; i < 100; i++) run(functions, script, counterState, &counter, 1);
+    std::cout << "samples: " << counter.sampleCount()
+              << ", dropped: " << counter.droppedSamples() << std::endl;
+    counter.writeFlat(std::cout);
+    std::cout << "collapsed:" << std::endl;
+    counter.writeCollapsed(std::cout);
+    std::cout << std::endl;
+
+    // Test 3
+    std::cout << "Test 3: Timer mode (SIGPROF every 200us)" << std::endl;
+    Profiler::Options timerOptions;
+    timerOptions.intervalMicros = 200;
+    Profiler timer(timerOptions);
+    ExecutionState timerState;
+    if (!timer.start(timerState)) {
+        std::cout << "could not start profiling timer" << std::endl;
+        return 1;
+    }
+    for (int i = 0; i < 2000; i++) run(functions, script, timerState, nullptr, 200);
+    timer.stop();
+    std::cout << "samples: " << (timer.sampleCount() > 0 ? "some" : "none")
+              << ", dropped: " << timer.droppedSamples() << std::endl;
+    timer.writeFlat(std::cout);
+    std::cout << std::endl;
+
+    // Test 4
+    std::cout << "Test 4: Buffer full keeps the newest samples" << std::endl;
+    Profiler::Options smallOptions;
+    smallOptions.bufferBytes = 2048;
+    smallOptions.instructionPeriod = 1;
+    Profiler small(smallOptions);
+    ExecutionState smallState;
+    for (int i = 0; i < 3; i++) run(functions, script, smallState, &small, 1);
+    std::cout << "samples: " << small.sampleCount()
+              << ", overwritten: " << small.overwrittenSamples() << std::endl;
+    std::cout << std::endl;
+
+    // Test 5
+    std::cout << "Test 5: Calls deeper than MAX_FRAMES are counted, not stored" << std::endl;
+    Profiler deep;
+    ExecutionState deepState;
+    for (int i = 0; i < ExecutionState::MAX_FRAMES + 6; i++) deepState.push("recurse", &leaf);
+    deepState.top().ip = leaf.bytes() + 1;
+    deep.sample(deepState);
+    std::ostringstream deepStacks;
+    deep.writeCollapsed(deepStacks);
+    std::string deepStack = deepStacks.str();
+    std::cout << "depth: " << deepState.depth << ", truncated: " << deepState.truncated << '\n';
+    std::cout << "stack ends with: " << deepStack.substr(deepStack.rfind(';') + 1);
+    deep.writeFlat(std::cout);
+    for (int i = 0; i < ExecutionState::MAX_FRAMES + 6; i++) deepState.pop();
+    std::cout << "depth after returning: " << deepState.depth << std::endl;
+    std::cout << std::endl;
+
+    // Test 6
+    std::cout << "Test 6: Each thread has its own timer" << std::endl;
+    DemoFunction& leafEntry = functions[byName["leaf"]];
+    std::string roots[2];
+    size_t threadSamples[2] = {0, 0};
+    auto profileThread = [&](int id, DemoFunction& entry) {
+        Profiler::Options options;
+        options.intervalMicros = 200;
+        Profiler profiler(options);
+        ExecutionState state;
+        if (!profiler.start(state)) return;
+        for (int i = 0; i < 1000; i++) run(functions, entry, state, nullptr, 200);
+        profiler.stop();
+        threadSamples[id] = profiler.sampleCount();
+        // Every stack should start in this thread's entry function.
+        std::ostringstream stacks;
+        profiler.writeCollapsed(stacks);
+        std::istringstream lines(stacks.str());
+        for (std::string line; std::getline(lines, line);) {
+            std::string root = line.substr(0, line.find(':'));
+            if (roots[id].find(root) == std::string::npos) roots[id] += root + " ";
+        }
+    };
+    std::thread first(profileThread, 0, std::ref(script));
+    std::thread second(profileThread, 1, std::ref(leafEntry));
+    first.join();
+    second.join();
+    for (int id = 0; id < 2; id++) {
+        std::cout << "thread " << id + 1 << ": " << (threadSamples[id] > 0 ? "sampled" : "no samples")
+                  << ", roots: " << roots[id] << '\n';
+    }
+
+    return 0;
+}
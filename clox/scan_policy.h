@@ -0,0 +1,39 @@
+#ifndef CLOX_SCAN_POLICY_H
+#define CLOX_SCAN_POLICY_H
+
+#include <type_traits>
+#include "token.h"
+
+// Compile-time switches for the scanners' inner loops. Every policy
+// instantiates its own loop, so a disabled feature is compiled out rather
+// than checked per character.
+//
+//   KeepTrivia         emit TOKEN_WHITESPACE / TOKEN_COMMENT tokens
+//   TrackLines         count newlines; otherwise every token is on line 1
+//   MaterializeLexemes copy each lexeme into Token::lexeme
+//   ReportErrors       print diagnostics to stderr
+//   TrackBrackets      build a BracketIndex while scanning
+template <bool KeepTrivia, bool TrackLines, bool MaterializeLexemes, bool ReportErrors,
+          bool TrackBrackets = false>
+struct ScanPolicy {
+    static constexpr bool keepTrivia = KeepTrivia;
+    static constexpr bool trackLines = TrackLines;
+    static constexpr bool materializeLexemes = MaterializeLexemes;
+    static constexpr bool reportErrors = ReportErrors;
+    static constexpr bool trackBrackets = TrackBrackets;
+
+    // With neither lexemes nor lines a Token would be mostly an empty
+    // std::string, so such policies emit bare token types instead.
+    using TokenRecord = std::conditional_t<MaterializeLexemes || TrackLines, Token, TokenType>;
+};
+
+// What the compiler front end needs; the default for both scanners.
+using FullScan = ScanPolicy<false, true, true, true>;
+// FullScan plus bracket partners, for the lazy function index.
+using IndexedScan = ScanPolicy<false, true, true, true, true>;
+// Token types only, e.g. for counting tokens or coarse highlighting.
+using TypesOnlyScan = ScanPolicy<false, false, false, false>;
+// Everything, including whitespace and comments, for formatters.
+using TriviaScan = ScanPolicy<true, true, true, true>;
+
+#endif
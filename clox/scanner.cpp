@@ -1,146 +1,52 @@
-#include <string>
-#include <list>
 #include <iostream>
-#include <unordered_map>        
-enum TokenType {
-    //single-character tokens
-    LEFT_PAREN, RIGHT_PAREN,
-    LEFT_BRACE, RIGHT_BRACE,
-    COMMA, DOT, SEMICOLON,
-    PLUS, MINUS, STAR, SLASH,
-    //one or two character tokens
-    BANG, BANG_EQUAL,
-    EQUAL, EQUAL_EQUAL,
-    GREATER, GREATER_EQUAL,
-    LESS, LESS_EQUAL,
-    //literals
-    IDENTIFIER, STRING, NUMBER,
-    //keywords
-    AND, CLASS, ELSE, FALSE, FUN, FOR, IF, NIL, OR, PRINT,
-    PRIVATE, RETURN, SUPER, THIS, TRUE, VAR, WHILE,
-    //end of file       
-    TOKEN_EOF
-};
-std::unordered_map<std::string, TokenType> keywords = {
-    {"and", AND},
-    {"class", CLASS},
-    {"else", ELSE},
-    {"false", FALSE},
-    {"for", FOR},
-    {"fun", FUN},
-    {"if", IF},
-    {"nil", NIL},
-    {"or", OR},
-    {"print", PRINT},
-    {"private", PRIVATE},
-    {"return", RETURN},
-    {"super", SUPER},
-    {"this", THIS},
-    {"true", TRUE},
-    {"var", VAR},
-    {"while", WHILE}
-};
+#include <string_view>
+#include <type_traits>
+#include "scanner.h"
+#include "utf8.h"
 
-std::string tokenTypeToString(TokenType type) {
-    switch(type) {
-        case LEFT_PAREN: return "LEFT_PAREN";
-        case RIGHT_PAREN: return "RIGHT_PAREN";
-        case LEFT_BRACE: return "LEFT_BRACE";
-        case RIGHT_BRACE: return "RIGHT_BRACE";
-        case COMMA: return "COMMA";
-        case DOT: return "DOT";
-        case SEMICOLON: return "SEMICOLON";
-        case PLUS: return "PLUS";
-        case MINUS: return "MINUS";
-        case STAR: return "STAR";
-        case SLASH: return "SLASH";
-        case BANG: return "BANG";
-        case BANG_EQUAL: return "BANG_EQUAL";
-        case EQUAL: return "EQUAL";
-        case EQUAL_EQUAL: return "EQUAL_EQUAL";
-        case GREATER: return "GREATER";
-        case GREATER_EQUAL: return "GREATER_EQUAL";
-        case LESS: return "LESS";
-        case LESS_EQUAL: return "LESS_EQUAL";
-        case IDENTIFIER: return "IDENTIFIER";
-        case STRING: return "STRING";
-        case NUMBER: return "NUMBER";
-        case AND: return "AND";
-        case CLASS: return "CLASS";
-        case ELSE: return "ELSE";
-        case FALSE: return "FALSE";
-        case FUN: return "FUN";
-        case FOR: return "FOR";
-        case IF: return "IF";
-        case NIL: return "NIL";
-        case OR: return "OR";
-        case PRINT: return "PRINT";
-        case PRIVATE: return "PRIVATE";
-        case RETURN: return "RETURN";
-        case SUPER: return "SUPER";
-        case THIS: return "THIS";
-        case TRUE: return "TRUE";
-        case VAR: return "VAR";
-        case WHILE: return "WHILE";
-        case TOKEN_EOF: return "TOKEN_EOF";
-        default: return "UNKNOWN";
-    }
+template <typename Policy>
+void BasicScanner<Policy>::reset(std::string_view source) {
+    this->source.assign(source);
+    clearTokens();
+    brackets.clear();
 }
-
-class Token
-{
-public:
-    TokenType type;
-    std::string lexeme;
-    int line;
-    Token(TokenType type, const std::string& lexeme, int line)
-        : type(type), lexeme(lexeme), line(line) {} 
-
-    std::string toString() const {
-        return tokenTypeToString(type) + " " + lexeme + " " + std::to_string(line);  
-    }
-};
-class Scanner
-{
-private:
-    std::string source;
-    std::list<Token> tokens;
-    int start = 0;
-    int current = 0;
-    int line = 1;
-
-    char advance();
-    char peek() const;
-    char peekNext() const;
-    bool match(char expected);
-    void addToken(TokenType type);
-    void addToken(TokenType type, const std::string& literal);
-    void scanToken();
-    void string();
-    void number();
-    void identifier();
-    bool isDigit(char c) const;
-    bool isAlpha(char c) const;
-    bool isAlphaNumeric(char c) const;
-    bool isAtEnd() const;
-
-public:
-    Scanner(const std::string& source) : source(source) {}
-    std::list<Token> scanTokens();
-};  
-std::list<Token> Scanner::scanTokens() {
+template <typename Policy>
+const std::vector<typename BasicScanner<Policy>::TokenRecord>&
+BasicScanner<Policy>::scanTokens() {
+    return scanChunk(1, true);
+}
+template <typename Policy>
+const std::vector<typename BasicScanner<Policy>::TokenRecord>&
+BasicScanner<Policy>::scanChunk(int firstLine, bool last) {
+    // Rescan from the top so calling this twice does not duplicate tokens.
+    clearTokens();
+    brackets.clear();
+    start = 0;
+    current = 0;
+    line = firstLine;
+    lastChunk = last;
+    resumeAt = source.length();
     while(!isAtEnd()) {
         // We are at the beginning of the next lexeme.
         start = current;
+        startLine = line;
         scanToken();
     }   
-    tokens.push_back(Token(TOKEN_EOF, "", line));
+    if (!last) {
+        // Moved back if a lexeme was left for the next piece.
+        if (resumeAt == source.length()) resumeAtLine = line;
+        return tokens;
+    }
+    addToken(TOKEN_EOF, current, 0);
+    if constexpr (Policy::trackBrackets) brackets.finish();
     return tokens; 
 }
-bool Scanner::isAtEnd() const {
+template <typename Policy>
+bool BasicScanner<Policy>::isAtEnd() const {
     return current >= source.length();
 }
-void Scanner::scanToken() {
+template <typename Policy>
+void BasicScanner<Policy>::scanToken() {
     char c = advance();
     switch (c) {
         case '(': addToken(LEFT_PAREN); break;
@@ -170,6 +76,8 @@ void Scanner::scanToken() {
           if(match('/'))
           {
           while(peek()!='\n' && !isAtEnd()) advance(); 
+          if constexpr (Policy::keepTrivia) addToken(TOKEN_COMMENT);
+          else deferToNextChunk();
           }
           else {
             addToken(SLASH);
@@ -178,10 +86,12 @@ void Scanner::scanToken() {
         case ' ':
         case '\r':
         case '\t':
-            // Ignore whitespace.
+            // Ignore whitespace unless the policy keeps it.
+            if constexpr (Policy::keepTrivia) whitespace();
             break;
         case '\n':
-            line++;
+            newline();
+            if constexpr (Policy::keepTrivia) whitespace();
             break;  
         case '"':
             string();
@@ -192,64 +102,139 @@ void Scanner::scanToken() {
             number();
          else if(isAlpha(c))
             identifier();
+         else if(static_cast<unsigned char>(c) >= 0x80)
+            unicodeCharacter();
 
             else {    
-            std::cerr << "[Line " << line << "] Error: Unexpected character '" << c << "'." << std::endl;
+            unexpectedCharacter(1);
             }
             break;  
             
     }   
 }
-char Scanner::advance() {
+template <typename Policy>
+char BasicScanner<Policy>::advance() {
     return source[current++];
 }
-char Scanner::peek() const {
+template <typename Policy>
+char BasicScanner<Policy>::peek() const {
     if (isAtEnd()) return '\0';
     return source[current];
 }
-char Scanner::peekNext() const {
+template <typename Policy>
+char BasicScanner<Policy>::peekNext() const {
     if (current + 1 >= source.length()) return '\0';
     return source[current + 1];
 }
-bool Scanner::match(char expected) {
+template <typename Policy>
+bool BasicScanner<Policy>::match(char expected) {
     if (isAtEnd()) return false;
     if (source[current] != expected) return false;
     current++;
     return true;
 }
-void Scanner::addToken(TokenType type)
+template <typename Policy>
+void BasicScanner<Policy>::newline() {
+    if constexpr (Policy::trackLines) line++;
+}
+template <typename Policy>
+bool BasicScanner<Policy>::deferToNextChunk() {
+    if (lastChunk) return false;
+    // Everything after a deferred lexeme is deferred with it.
+    if (resumeAt != source.length()) return true;
+    // Scanning a lexeme looks at most one UTF-8 sequence past it, and
+    // nothing but a string continues past a newline.
+    if (current + 4 <= source.length() ||
+        std::string_view(source).substr(current).find('\n') != std::string_view::npos) {
+        return false;
+    }
+    resumeAt = start;
+    resumeAtLine = startLine;
+    return true;
+}
+template <typename Policy>
+void BasicScanner<Policy>::error(const char* message) {
+    if (deferToNextChunk()) return;
+    if constexpr (Policy::reportErrors) {
+        *errors << "[Line " << line << "] Error: " << message << std::endl;
+    }
+}
+template <typename Policy>
+void BasicScanner<Policy>::unexpectedCharacter(int length) {
+    if (deferToNextChunk()) return;
+    if constexpr (Policy::reportErrors) {
+        *errors << "[Line " << line << "] Error: Unexpected character '"
+                << std::string_view(source).substr(start, length) << "'." << std::endl;
+    }
+}
+template <typename Policy>
+void BasicScanner<Policy>::clearTokens()
 {
-  std::string text= source.substr(start, current - start);
-  tokens.push_back(Token(type, text, line));  
+  if constexpr (Policy::materializeLexemes) lexemes.reclaim(tokens);
+  else tokens.clear();
+}
+template <typename Policy>
+void BasicScanner<Policy>::addToken(TokenType type)
+{
+  addToken(type, start, current - start);
 }
 
-void Scanner::addToken(TokenType type, const std::string& literal)
+template <typename Policy>
+void BasicScanner<Policy>::addToken(TokenType type, size_t offset, size_t length)
 {
-  std::string text= source.substr(start, current - start);
-  tokens.push_back(Token(type, literal, line));  
+  if (deferToNextChunk()) return;
+  if constexpr (std::is_same_v<TokenRecord, TokenType>) {
+    tokens.push_back(type);
+  } else if constexpr (Policy::materializeLexemes) {
+    tokens.emplace_back(type, lexemes.take(std::string_view(source).substr(offset, length)), line);
+  } else {
+    tokens.emplace_back(type, std::string(), line);
+  }
+  if constexpr (Policy::trackBrackets) brackets.add(type, line);
+}
+template <typename Policy>
+void BasicScanner<Policy>::whitespace() {
+    for (;;) {
+        char c = peek();
+        if (c == '\n') newline();
+        else if (c != ' ' && c != '\r' && c != '\t') break;
+        advance();
+    }
+    addToken(TOKEN_WHITESPACE);
 }
-void Scanner::string() {
+template <typename Policy>
+void BasicScanner<Policy>::string() {
     while (peek() != '"' && !isAtEnd()) {
-        if (peek() == '\n') line++;
+        if (peek() == '\n') newline();
         advance();
     }   
 
     if (isAtEnd()) {
-       std::cerr << "[Line " << line << "] Error: Unterminated string." << std::endl;
+       // Not an error yet if the rest of the literal is in the next piece.
+       error("Unterminated string.");
        return;
     }
 
     // The closing ".
     advance();
 
+    // Only non-ASCII contents need decoding; validateUtf8 skips ASCII runs
+    // in blocks.
+    size_t length = current - start - 2;
+    if (validateUtf8(source.data() + start + 1, length) != length) {
+       error("Invalid UTF-8 in string.");
+       return;
+    }
+
     // Trim the surrounding quotes.
-    std::string value = source.substr(start + 1, current - start - 2);
-    addToken(STRING, value);
+    addToken(STRING, start + 1, length);
 }   
-bool Scanner::isDigit(char c) const {
+template <typename Policy>
+bool BasicScanner<Policy>::isDigit(char c) const {
     return c >= '0' && c <= '9';
 }
-void Scanner::number() {
+template <typename Policy>
+void BasicScanner<Policy>::number() {
     while (isDigit(peek())) advance();
 
     // Look for a fractional part.  
@@ -259,127 +244,69 @@ void Scanner::number() {
 
         while (isDigit(peek())) advance();
     }
-    std::string text = source.substr(start, current - start);
-    addToken(NUMBER, text);
+    addToken(NUMBER);
 }
-bool Scanner::isAlpha(char c) const {
+template <typename Policy>
+bool BasicScanner<Policy>::isAlpha(char c) const {
     return (c >= 'a' && c <= 'z') ||
            (c >= 'A' && c <= 'Z') ||        
            c == '_';
 }
-void Scanner::identifier() {
-  while(isAlphaNumeric(peek()))
+template <typename Policy>
+int BasicScanner<Policy>::unicodeIdentifierLength(bool first) const {
+    if (isAtEnd() || static_cast<unsigned char>(source[current]) < 0x80) return 0;
+    uint32_t codepoint;
+    int length = decodeUtf8(source.data() + current, source.data() + source.length(), &codepoint);
+    if (length == 0) return 0;
+    bool allowed = first ? isXidStart(codepoint) : isXidContinue(codepoint);
+    return allowed ? length : 0;
+}
+template <typename Policy>
+void BasicScanner<Policy>::unicodeCharacter() {
+    // The lead byte has already been consumed; look at the whole sequence.
+    current = start;
+    int length = unicodeIdentifierLength(true);
+    if (length > 0) {
+        current += length;
+        identifier();
+        return;
+    }
+
+    uint32_t codepoint;
+    length = decodeUtf8(source.data() + current, source.data() + source.length(), &codepoint);
+    if (length == 0) {
+        error("Invalid UTF-8 byte.");
+        current = start + 1;
+        return;
+    }
+    current = start + length;
+    unexpectedCharacter(length);
+}
+template <typename Policy>
+void BasicScanner<Policy>::identifier() {
+  for(;;)
   {
-    advance();
+    if(isAlphaNumeric(peek()))
+    {
+      advance();
+      continue;
+    }
+    // ASCII is the common case; only fall back to decoding on high bytes.
+    int length=unicodeIdentifierLength(false);
+    if(length==0) break;
+    current+=length;
   }  
 
-std::string text=source.substr(start,current-start);
-TokenType type;
-if(keywords.find(text)==keywords.end())
-{
-type=IDENTIFIER;
-}
-else{
-  type=keywords[text];  
-}
-addToken(type);
+addToken(identifierType(std::string_view(source).substr(start,current-start)));
 }
 
-bool Scanner::isAlphaNumeric(char c) const
+template <typename Policy>
+bool BasicScanner<Policy>::isAlphaNumeric(char c) const
 {
    return isAlpha(c)||isDigit(c); 
 }
-int main(){
-    std::cout << "=== Scanner Test Cases ===" << std::endl << std::endl;
-
-    // Test 1: Single character tokens
-    std::cout << "Test 1: Single character tokens" << std::endl;
-    Scanner scanner1("(){},.-+;*");
-    std::list<Token> tokens1 = scanner1.scanTokens();
-    for (const auto& token : tokens1) {
-        std::cout << token.toString() << std::endl;
-    }
-    std::cout << std::endl;
-
-    // Test 2: Two character tokens
-    std::cout << "Test 2: Two character tokens" << std::endl;
-    Scanner scanner2("! != == = < <= > >=");
-    std::list<Token> tokens2 = scanner2.scanTokens();
-    for (const auto& token : tokens2) {
-        std::cout << token.toString() << std::endl;
-    }
-    std::cout << std::endl;
-
-    // Test 3: Comments
-    std::cout << "Test 3: Comments" << std::endl;
-    Scanner scanner3("// this is a comment\n(\n// another comment\n)");
-    std::list<Token> tokens3 = scanner3.scanTokens();
-    for (const auto& token : tokens3) {
-        std::cout << token.toString() << std::endl;
-    }
-    std::cout << std::endl;
-
-    // Test 4: Strings
-    std::cout << "Test 4: Strings" << std::endl;
-    Scanner scanner4("\"hello world\" \"test\"");
-    std::list<Token> tokens4 = scanner4.scanTokens();
-    for (const auto& token : tokens4) {
-        std::cout << token.toString() << std::endl;
-    }
-    std::cout << std::endl;
-
-    // Test 5: Numbers
-    std::cout << "Test 5: Numbers" << std::endl;
-    Scanner scanner5("123 456.789 0.123");
-    std::list<Token> tokens5 = scanner5.scanTokens();
-    for (const auto& token : tokens5) {
-        std::cout << token.toString() << std::endl;
-    }
-    std::cout << std::endl;
-
-    // Test 6: Identifiers and keywords
-    std::cout << "Test 6: Identifiers and keywords" << std::endl;
-    Scanner scanner6("var x = 10; if while class fun");
-    std::list<Token> tokens6 = scanner6.scanTokens();
-    for (const auto& token : tokens6) {
-        std::cout << token.toString() << std::endl;
-    }
-    std::cout << std::endl;
-
-    // Test 7: Mixed expression
-    std::cout << "Test 7: Mixed expression" << std::endl;
-    Scanner scanner7("var average = (min + max) / 2;");
-    std::list<Token> tokens7 = scanner7.scanTokens();
-    for (const auto& token : tokens7) {
-        std::cout << token.toString() << std::endl;
-    }
-    std::cout << std::endl;
 
-    // Test 8: Error case - unterminated string
-    std::cout << "Test 8: Error case - unterminated string" << std::endl;
-    Scanner scanner8("\"unterminated");
-    std::list<Token> tokens8 = scanner8.scanTokens();
-    for (const auto& token : tokens8) {
-        std::cout << token.toString() << std::endl;
-    }
-    std::cout << std::endl;
-
-    // Test 9: Error case - unexpected character
-    std::cout << "Test 9: Error case - unexpected character" << std::endl;
-    Scanner scanner9("@ # $");
-    std::list<Token> tokens9 = scanner9.scanTokens();
-    for (const auto& token : tokens9) {
-        std::cout << token.toString() << std::endl;
-    }
-    std::cout << std::endl;
-
-    // Test 10: Multi-line code
-    std::cout << "Test 10: Multi-line code" << std::endl;
-    Scanner scanner10("var x = 10;\nprint x;\nif (x > 5) {\n  print \"big\";\n}");
-    std::list<Token> tokens10 = scanner10.scanTokens();
-    for (const auto& token : tokens10) {
-        std::cout << token.toString() << std::endl;
-    }
-
-    return 0;
-}
+template class BasicScanner<FullScan>;
+template class BasicScanner<IndexedScan>;
+template class BasicScanner<TypesOnlyScan>;
+template class BasicScanner<TriviaScan>;
@@ -0,0 +1,98 @@
+#ifndef CLOX_SCANNER_H
+#define CLOX_SCANNER_H
+
+#include <iostream>
+#include <string>
+#include <string_view>
+#include <vector>
+#include "bracket_index.h"
+#include "scan_policy.h"
+#include "token.h"
+
+// Hand-written scanner. The scanning loop is specialized per Policy (see
+// scan_policy.h); scanner.cpp instantiates FullScan, IndexedScan,
+// TypesOnlyScan and TriviaScan.
+template <typename Policy>
+class BasicScanner
+{
+public:
+    // Token for most policies, a bare TokenType for TypesOnlyScan.
+    using TokenRecord = typename Policy::TokenRecord;
+
+private:
+    std::string source;
+    // Kept across reset() so repeated scans reuse the buffer's capacity.
+    std::vector<TokenRecord> tokens;
+    // Lexeme buffers of the previous scan, reused by the next one.
+    LexemePool lexemes;
+    // Only filled in when Policy::trackBrackets is set.
+    BracketIndex brackets{Policy::reportErrors};
+    // Byte offsets; size_t so sources past 2 GiB do not overflow.
+    size_t start = 0;
+    size_t current = 0;
+    int line = 1;
+    int startLine = 1;
+    // scanChunk() state: whether more input follows this piece, and where
+    // the next piece has to start.
+    bool lastChunk = true;
+    size_t resumeAt = 0;
+    int resumeAtLine = 1;
+    std::ostream* errors = &std::cerr;
+
+    char advance();
+    char peek() const;
+    char peekNext() const;
+    bool match(char expected);
+    void newline();
+    // In a piece with more input to follow, true if the current lexeme
+    // might continue past the end; it is then left for the next piece.
+    bool deferToNextChunk();
+    void error(const char* message);
+    void unexpectedCharacter(int length);
+    void clearTokens();
+    void addToken(TokenType type);
+    void addToken(TokenType type, size_t offset, size_t length);
+    void scanToken();
+    void whitespace();
+    void string();
+    void number();
+    void identifier();
+    void unicodeCharacter();
+    int unicodeIdentifierLength(bool first) const;
+    bool isDigit(char c) const;
+    bool isAlpha(char c) const;
+    bool isAlphaNumeric(char c) const;
+    bool isAtEnd() const;
+
+public:
+    BasicScanner() = default;
+    BasicScanner(std::string_view source) : source(source) {}
+    // Replaces the source so the same scanner can lex another snippet.
+    // Copies into the retained buffer, so no allocation once it is large
+    // enough.
+    void reset(std::string_view source);
+    const std::vector<TokenRecord>& scanTokens();
+    // Scans one piece of a larger input, so a caller can stream a file
+    // without holding all of it. Pass `last` false for every piece but the
+    // final one. A piece may end anywhere: a lexeme that could continue
+    // past its end (an open string, or anything ending within a few bytes
+    // of it but before a newline) is not emitted but left for the next
+    // piece, which starts at resumeOffset() of this one, on line
+    // resumeLine(). Only the last piece gets a TOKEN_EOF, and brackets are
+    // only matched within one piece.
+    const std::vector<TokenRecord>& scanChunk(int firstLine, bool last);
+    size_t resumeOffset() const { return resumeAt; }
+    int resumeLine() const { return resumeAtLine; }
+    // With a policy that tracks brackets, scanTokens() also pairs them up
+    // and reports unbalanced ones.
+    const BracketIndex& bracketIndex() const { return brackets; }
+    // Diagnostics go to std::cerr unless redirected, e.g. per isolate.
+    void setErrorStream(std::ostream& stream) {
+        errors = &stream;
+        brackets.setErrorStream(stream);
+    }
+};
+
+using Scanner = BasicScanner<FullScan>;
+
+#endif
@@ -0,0 +1,94 @@
+// Scanner throughput benchmark.
+//
+// Usage: scanner_bench [file] [iterations]
+//
+// Scans the file (or a generated corpus) with each scanner under each scan
+// policy and reports MB/s. Compare FullScan against TypesOnlyScan to see
+// what the policy-specialized loops save. Also reports the heap allocations
+// of a rescan after the first, which should be zero: the scanners keep their
+// token vectors and lexeme buffers across reset().
+#include <chrono>
+#include <cstdlib>
+#include <new>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include "scanner.h"
+#include "scanner_table.h"
+
+// Counts every allocation the program makes.
+static size_t allocations = 0;
+
+void* operator new(size_t size) {
+    allocations++;
+    if (void* memory = std::malloc(size == 0 ? 1 : size)) return memory;
+    throw std::bad_alloc();
+}
+void operator delete(void* memory) noexcept { std::free(memory); }
+void operator delete(void* memory, size_t) noexcept { std::free(memory); }
+
+static std::string generateCorpus() {
+    static const char* snippet =
+        "// Compute a running average.\n"
+        "fun average(values, count) {\n"
+        "    var total = 0;\n"
+        "    for (var i = 0; i < count; i = i + 1) {\n"
+        "        total = total + values.get(i) * 1.5;\n"
+        "    }\n"
+        "    if (count != 0 and total >= 10) print \"larger than the threshold\";\n"
+        "    return total / count;\n"
+        "}\n";
+    std::string corpus;
+    while (corpus.size() < 8 * 1024 * 1024) corpus += snippet;
+    return corpus;
+}
+
+template <typename ScannerType>
+static void bench(const char* name, const std::string& source, int iterations) {
+    ScannerType scanner;
+    size_t tokenCount = 0;
+    auto begin = std::chrono::steady_clock::now();
+    for (int i = 0; i < iterations; i++) {
+        scanner.reset(source);
+        tokenCount = scanner.scanTokens().size();
+    }
+    auto end = std::chrono::steady_clock::now();
+
+    // Steady state: the same input again once the buffers are warm.
+    size_t before = allocations;
+    scanner.reset(source);
+    scanner.scanTokens();
+    size_t rescanAllocations = allocations - before;
+
+    double seconds = std::chrono::duration<double>(end - begin).count();
+    double megabytes = static_cast<double>(source.size()) * iterations / (1024.0 * 1024.0);
+    std::cout << name << ": " << tokenCount << " tokens, "
+              << megabytes / seconds << " MB/s, "
+              << rescanAllocations << " allocations per rescan\n";
+}
+
+int main(int argc, char* argv[]) {
+    std::string source;
+    if (argc > 1) {
+        std::ifstream file(argv[1], std::ios::binary);
+        if (!file) {
+            std::cerr << "Could not read file \"" << argv[1] << "\"." << std::endl;
+            return 74;
+        }
+        std::stringstream contents;
+        contents << file.rdbuf();
+        source = contents.str();
+    } else {
+        source = generateCorpus();
+    }
+    int iterations = argc > 2 ? std::atoi(argv[2]) : 5;
+
+    bench<BasicScanner<FullScan>>("Scanner            FullScan     ", source, iterations);
+    bench<BasicScanner<TypesOnlyScan>>("Scanner            TypesOnlyScan", source, iterations);
+    bench<BasicScanner<TriviaScan>>("Scanner            TriviaScan   ", source, iterations);
+    bench<BasicTableDrivenScanner<FullScan>>("TableDrivenScanner FullScan     ", source, iterations);
+    bench<BasicTableDrivenScanner<TypesOnlyScan>>("TableDrivenScanner TypesOnlyScan", source, iterations);
+    bench<BasicTableDrivenScanner<TriviaScan>>("TableDrivenScanner TriviaScan   ", source, iterations);
+    return 0;
+}
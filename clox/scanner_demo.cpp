@@ -0,0 +1,242 @@
+#include <algorithm>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <vector>
+#include "function_index.h"
+#include "scanner.h"
+
+int main(){
+    std::cout << "=== Scanner Test Cases ===" << std::endl << std::endl;
+
+    // Test 1: Single character tokens
+    std::cout << "Test 1: Single character tokens" << std::endl;
+    Scanner scanner1("(){},.-+;*");
+    std::vector<Token> tokens1 = scanner1.scanTokens();
+    for (const auto& token : tokens1) {
+        std::cout << token.toString() << '\n';
+    }
+    std::cout << std::endl;
+
+    // Test 2: Two character tokens
+    std::cout << "Test 2: Two character tokens" << std::endl;
+    Scanner scanner2("! != == = < <= > >=");
+    std::vector<Token> tokens2 = scanner2.scanTokens();
+    for (const auto& token : tokens2) {
+        std::cout << token.toString() << '\n';
+    }
+    std::cout << std::endl;
+
+    // Test 3: Comments
+    std::cout << "Test 3: Comments" << std::endl;
+    Scanner scanner3("// this is a comment\n(\n// another comment\n)");
+    std::vector<Token> tokens3 = scanner3.scanTokens();
+    for (const auto& token : tokens3) {
+        std::cout << token.toString() << '\n';
+    }
+    std::cout << std::endl;
+
+    // Test 4: Strings
+    std::cout << "Test 4: Strings" << std::endl;
+    Scanner scanner4("\"hello world\" \"test\"");
+    std::vector<Token> tokens4 = scanner4.scanTokens();
+    for (const auto& token : tokens4) {
+        std::cout << token.toString() << '\n';
+    }
+    std::cout << std::endl;
+
+    // Test 5: Numbers
+    std::cout << "Test 5: Numbers" << std::endl;
+    Scanner scanner5("123 456.789 0.123");
+    std::vector<Token> tokens5 = scanner5.scanTokens();
+    for (const auto& token : tokens5) {
+        std::cout << token.toString() << '\n';
+    }
+    std::cout << std::endl;
+
+    // Test 6: Identifiers and keywords
+    std::cout << "Test 6: Identifiers and keywords" << std::endl;
+    Scanner scanner6("var x = 10; if while class fun");
+    std::vector<Token> tokens6 = scanner6.scanTokens();
+    for (const auto& token : tokens6) {
+        std::cout << token.toString() << '\n';
+    }
+    std::cout << std::endl;
+
+    // Test 7: Mixed expression
+    std::cout << "Test 7: Mixed expression" << std::endl;
+    Scanner scanner7("var average = (min + max) / 2;");
+    std::vector<Token> tokens7 = scanner7.scanTokens();
+    for (const auto& token : tokens7) {
+        std::cout << token.toString() << '\n';
+    }
+    std::cout << std::endl;
+
+    // Test 8: Error case - unterminated string
+    std::cout << "Test 8: Error case - unterminated string" << std::endl;
+    Scanner scanner8("\"unterminated");
+    std::vector<Token> tokens8 = scanner8.scanTokens();
+    for (const auto& token : tokens8) {
+        std::cout << token.toString() << '\n';
+    }
+    std::cout << std::endl;
+
+    // Test 9: Error case - unexpected character
+    std::cout << "Test 9: Error case - unexpected character" << std::endl;
+    Scanner scanner9("@ # $");
+    std::vector<Token> tokens9 = scanner9.scanTokens();
+    for (const auto& token : tokens9) {
+        std::cout << token.toString() << '\n';
+    }
+    std::cout << std::endl;
+
+    // Test 10: Multi-line code
+    std::cout << "Test 10: Multi-line code" << std::endl;
+    Scanner scanner10("var x = 10;\nprint x;\nif (x > 5) {\n  print \"big\";\n}");
+    std::vector<Token> tokens10 = scanner10.scanTokens();
+    for (const auto& token : tokens10) {
+        std::cout << token.toString() << '\n';
+    }
+    std::cout << std::endl;
+
+    // Test 11: Reusing one scanner for several snippets
+    std::cout << "Test 11: Reusing a scanner with reset()" << std::endl;
+    Scanner reused;
+    const char* snippets[] = {"var a = 1;", "print a;", "print a;"};
+    for (const char* snippet : snippets) {
+        reused.reset(snippet);
+        for (const auto& token : reused.scanTokens()) {
+            std::cout << token.toString() << '\n';
+        }
+    }
+    std::cout << "Rescan without reset: " << reused.scanTokens().size() << " tokens" << std::endl;
+    std::cout << std::endl;
+
+    // Test 12: UTF-8 identifiers and strings
+    std::cout << "Test 12: UTF-8 identifiers and strings" << std::endl;
+    Scanner scanner12("var caf\u00e9 = \"h\u00e9llo \u4e16\u754c\";\nprint \u03c0\u0394 \u20ac \xff;\n\"bad \xc0\xaf\"");
+    for (const auto& token : scanner12.scanTokens()) {
+        std::cout << token.toString() << '\n';
+    }
+    std::cout << std::endl;
+
+    // Test 13: Bracket matching
+    std::cout << "Test 13: Bracket matching" << std::endl;
+    BasicScanner<IndexedScan> bracketScanner("fun f(a) { if (a) { print (a); } }");
+    const auto& bracketTokens = bracketScanner.scanTokens();
+    const BracketIndex& index = bracketScanner.bracketIndex();
+    for (int i = 0; i < static_cast<int>(bracketTokens.size()); i++) {
+        if (index.partnerOf(i) >= 0) {
+            std::cout << i << " " << bracketTokens[i].lexeme << " <-> " << index.partnerOf(i) << '\n';
+        }
+    }
+    bracketScanner.reset("(a { b ) }\n}");
+    bracketScanner.scanTokens();
+    std::cout << "Unbalanced errors: " << bracketScanner.bracketIndex().errorCount() << std::endl;
+    // Policies without ReportErrors get an index that only counts.
+    BracketIndex quiet(false);
+    quiet.add(LEFT_PAREN, 1);
+    quiet.add(LEFT_BRACE, 1);
+    quiet.add(TOKEN_EOF, 1);
+    quiet.finish();
+    std::cout << "Counted silently: " << quiet.errorCount() << std::endl;
+    std::cout << std::endl;
+
+    // Test 14: Scan policies
+    std::cout << "Test 14: Scan policies" << std::endl;
+    BasicScanner<TriviaScan> triviaScanner("var a; // note\n  print a;");
+    for (const auto& token : triviaScanner.scanTokens()) {
+        std::cout << token.toString() << '\n';
+    }
+    BasicScanner<TypesOnlyScan> typesScanner("var a = \"x\";\n@ print a;");
+    // TypesOnlyScan emits bare TokenTypes rather than Tokens.
+    for (TokenType type : typesScanner.scanTokens()) {
+        std::cout << tokenTypeName(type) << ' ';
+    }
+    std::cout << '\n';
+    std::cout << std::endl;
+
+    // Test 15: Lazy function bodies
+    std::cout << "Test 15: Lazy function bodies" << std::endl;
+    BasicScanner<IndexedScan> lazyScanner(
+        "fun used(a) { fun inner() { return a; } return inner(); }\n"
+        "fun unused() { print \"never\"; }\n"
+        "class Point < Base { init(x) { this.x = x; } norm() { return 1; } }\n"
+        "print used(1);");
+    const auto& lazyTokens = lazyScanner.scanTokens();
+    // Stand-in for the compiler: count body tokens and nested functions.
+    LazyFunctionTable<std::string> lazyFunctions(lazyTokens, lazyScanner.bracketIndex(),
+        [&](const FunctionRange& range) {
+            auto nested = indexFunctions(lazyTokens, lazyScanner.bracketIndex(),
+                                         range.bodyStart + 1, range.bodyEnd);
+            return std::to_string(range.bodyEnd - range.bodyStart + 1) + " tokens, " +
+                   std::to_string(nested.size()) + " nested";
+        });
+    std::cout << "Declared: " << lazyFunctions.declaredFunctions() << '\n';
+    std::cout << "used: " << *lazyFunctions.get("used") << '\n';
+    std::cout << "used again: " << *lazyFunctions.get("used") << '\n';
+    std::cout << "Point.init: " << *lazyFunctions.get("Point.init") << '\n';
+    std::cout << "missing: " << (lazyFunctions.get("missing") == nullptr ? "not found" : "found") << '\n';
+    std::cout << "Compiled: " << lazyFunctions.compiledFunctions() << std::endl;
+    // A malformed declaration is skipped; the ones after it still count.
+    lazyScanner.reset("fun broken(a { }\nfun nobody;\nfun after() { }\nclass C { m( {} n() {} }");
+    const auto& skipTokens = lazyScanner.scanTokens();
+    for (const FunctionRange& range : indexFunctions(skipTokens, lazyScanner.bracketIndex(), 0,
+                                                     static_cast<int>(skipTokens.size()))) {
+        std::cout << "indexed after errors: " << range.name << '\n';
+    }
+    // Functions declared in a block are local to it.
+    lazyScanner.reset("{ fun helper() {} }\nif (x) { fun other() {} }\nfun top() { }");
+    const auto& blockTokens = lazyScanner.scanTokens();
+    for (const FunctionRange& range : indexFunctions(blockTokens, lazyScanner.bracketIndex(), 0,
+                                                     static_cast<int>(blockTokens.size()))) {
+        std::cout << "indexed past blocks: " << range.name << '\n';
+    }
+    // Without a bracket index every lookup would fail, so this is an error.
+    Scanner plainScanner("fun f() {}");
+    try {
+        indexFunctions(plainScanner.scanTokens(), plainScanner.bracketIndex(), 0, 1);
+    } catch (const std::invalid_argument& error) {
+        std::cout << "Rejected: " << error.what() << std::endl;
+    }
+    std::cout << std::endl;
+
+    // Test 16: Scanning in pieces cut anywhere, as lox-tokens streams input
+    std::cout << "Test 16: Scanning in pieces" << std::endl;
+    const char* streamed[] = {
+        "var total = 1.5 + count; print \"a long line, no newline\"; // done",
+        "print \"spans\ntwo lines\"; print caf\u00e9;\nprint 2;",
+        "print 1;\nvar s = \"never closed;\nprint s;",
+    };
+    for (const char* text : streamed) {
+        std::string whole;
+        Scanner wholeScanner(text);
+        for (const auto& token : wholeScanner.scanTokens()) whole += token.toString() + '\n';
+
+        // Seven new bytes per piece, on top of whatever the last one left.
+        std::string source = text;
+        std::string pieces;
+        Scanner pieceScanner;
+        size_t offset = 0;
+        size_t end = 0;
+        int pieceLine = 1;
+        int scans = 0;
+        for (;;) {
+            end = std::min(end + 7, source.size());
+            bool last = end == source.size();
+            pieceScanner.reset(std::string_view(source).substr(offset, end - offset));
+            for (const auto& token : pieceScanner.scanChunk(pieceLine, last)) {
+                pieces += token.toString() + '\n';
+            }
+            scans++;
+            if (last) break;
+            offset += pieceScanner.resumeOffset();
+            pieceLine = pieceScanner.resumeLine();
+        }
+        std::cout << scans << " pieces, " << (pieces == whole ? "same" : "different")
+                  << " tokens as one scan" << std::endl;
+    }
+
+    return 0;
+}
@@ -1,177 +1,10 @@
-#include <string>
-#include <vector>
 #include <iostream>
-#include <unordered_map>
-#include <cctype>
+#include <string_view>
+#include <type_traits>
+#include "scanner_table.h"
+#include "utf8.h"
 
-enum TokenType {
-    //single-character tokens
-    LEFT_PAREN, RIGHT_PAREN,
-    LEFT_BRACE, RIGHT_BRACE,
-    COMMA, DOT, SEMICOLON,
-    PLUS, MINUS, STAR, SLASH,
-    //one or two character tokens
-    BANG, BANG_EQUAL,
-    EQUAL, EQUAL_EQUAL,
-    GREATER, GREATER_EQUAL,
-    LESS, LESS_EQUAL,
-    //literals
-    IDENTIFIER, STRING, NUMBER,
-    //keywords
-    AND, CLASS, ELSE, FALSE, FUN, FOR, IF, NIL, OR, PRINT,
-    PRIVATE, RETURN, SUPER, THIS, TRUE, VAR, WHILE,
-    //end of file       
-    TOKEN_EOF,
-    TOKEN_ERROR
-};
-
-// DFA States
-enum State {
-    START,
-    // Single character states
-    IN_LEFT_PAREN, IN_RIGHT_PAREN, IN_LEFT_BRACE, IN_RIGHT_BRACE,
-    IN_COMMA, IN_DOT, IN_SEMICOLON, IN_PLUS, IN_MINUS, IN_STAR,
-    // Multi-character states
-    IN_BANG, IN_BANG_EQUAL,
-    IN_EQUAL, IN_EQUAL_EQUAL,
-    IN_GREATER, IN_GREATER_EQUAL,
-    IN_LESS, IN_LESS_EQUAL,
-    IN_SLASH, IN_COMMENT,
-    // Literal states
-    IN_STRING, STRING_END,
-    IN_NUMBER, IN_NUMBER_DOT, IN_NUMBER_DECIMAL,
-    IN_IDENTIFIER,
-    // Special states
-    ACCEPT,
-    ERROR,
-    NUM_STATES
-};
-
-// Character classes for transition table
-enum CharClass {
-    CHAR_LPAREN, CHAR_RPAREN, CHAR_LBRACE, CHAR_RBRACE,
-    CHAR_COMMA, CHAR_DOT, CHAR_SEMICOLON,
-    CHAR_PLUS, CHAR_MINUS, CHAR_STAR,
-    CHAR_BANG, CHAR_EQUAL, CHAR_GREATER, CHAR_LESS,
-    CHAR_SLASH, CHAR_QUOTE,
-    CHAR_DIGIT, CHAR_ALPHA, CHAR_UNDERSCORE,
-    CHAR_NEWLINE, CHAR_WHITESPACE,
-    CHAR_OTHER,
-    NUM_CHAR_CLASSES
-};
-
-std::unordered_map<std::string, TokenType> keywords = {
-    {"and", AND},
-    {"class", CLASS},
-    {"else", ELSE},
-    {"false", FALSE},
-    {"for", FOR},
-    {"fun", FUN},
-    {"if", IF},
-    {"nil", NIL},
-    {"or", OR},
-    {"print", PRINT},
-    {"private", PRIVATE},
-    {"return", RETURN},
-    {"super", SUPER},
-    {"this", THIS},
-    {"true", TRUE},
-    {"var", VAR},
-    {"while", WHILE}
-};
-
-std::string tokenTypeToString(TokenType type) {
-    switch(type) {
-        case LEFT_PAREN: return "LEFT_PAREN";
-        case RIGHT_PAREN: return "RIGHT_PAREN";
-        case LEFT_BRACE: return "LEFT_BRACE";
-        case RIGHT_BRACE: return "RIGHT_BRACE";
-        case COMMA: return "COMMA";
-        case DOT: return "DOT";
-        case SEMICOLON: return "SEMICOLON";
-        case PLUS: return "PLUS";
-        case MINUS: return "MINUS";
-        case STAR: return "STAR";
-        case SLASH: return "SLASH";
-        case BANG: return "BANG";
-        case BANG_EQUAL: return "BANG_EQUAL";
-        case EQUAL: return "EQUAL";
-        case EQUAL_EQUAL: return "EQUAL_EQUAL";
-        case GREATER: return "GREATER";
-        case GREATER_EQUAL: return "GREATER_EQUAL";
-        case LESS: return "LESS";
-        case LESS_EQUAL: return "LESS_EQUAL";
-        case IDENTIFIER: return "IDENTIFIER";
-        case STRING: return "STRING";
-        case NUMBER: return "NUMBER";
-        case AND: return "AND";
-        case CLASS: return "CLASS";
-        case ELSE: return "ELSE";
-        case FALSE: return "FALSE";
-        case FUN: return "FUN";
-        case FOR: return "FOR";
-        case IF: return "IF";
-        case NIL: return "NIL";
-        case OR: return "OR";
-        case PRINT: return "PRINT";
-        case PRIVATE: return "PRIVATE";
-        case RETURN: return "RETURN";
-        case SUPER: return "SUPER";
-        case THIS: return "THIS";
-        case TRUE: return "TRUE";
-        case VAR: return "VAR";
-        case WHILE: return "WHILE";
-        case TOKEN_EOF: return "TOKEN_EOF";
-        case TOKEN_ERROR: return "TOKEN_ERROR";
-        default: return "UNKNOWN";
-    }
-}
-
-class Token {
-public:
-    TokenType type;
-    std::string lexeme;
-    int line;
-    
-    Token(TokenType type, const std::string& lexeme, int line)
-        : type(type), lexeme(lexeme), line(line) {}
-    
-    std::string toString() const {
-        return tokenTypeToString(type) + " " + lexeme + " " + std::to_string(line);
-    }
-};
-
-class TableDrivenScanner {
-private:
-    std::string source;
-    std::vector<Token> tokens;
-    int start = 0;
-    int current = 0;
-    int line = 1;
-    
-    // Transition Table: [current_state][character_class] -> next_state
-    State transitionTable[NUM_STATES][NUM_CHAR_CLASSES];
-    
-    // Accepting states map to token types
-    std::unordered_map<State, TokenType> acceptingStates;
-    
-    void initializeTransitionTable();
-    void initializeAcceptingStates();
-    CharClass getCharClass(char c) const;
-    bool isAtEnd() const;
-    char peek() const;
-    char advance();
-    void addToken(TokenType type);
-    void addToken(TokenType type, const std::string& literal);
-    void scanToken();
-    
-public:
-    TableDrivenScanner(const std::string& source);
-    std::vector<Token> scanTokens();
-    void printTransitionTable();
-};
-
-TableDrivenScanner::TableDrivenScanner(const std::string& source) : source(source) {
+DfaTables::DfaTables() {
     // Initialize all transitions to ERROR state
     for (int i = 0; i < NUM_STATES; i++) {
         for (int j = 0; j < NUM_CHAR_CLASSES; j++) {
@@ -182,13 +15,32 @@ TableDrivenScanner::TableDrivenScanner(const std::string& source) : source(sourc
     initializeAcceptingStates();
 }
 
-void TableDrivenScanner::initializeTransitionTable() {
+const DfaTables& DfaTables::shared() {
+    // Built once, on first use; C++ guarantees the initialization is
+    // thread-safe, and the tables are never written afterwards.
+    static const DfaTables tables;
+    return tables;
+}
+
+template <typename Policy>
+BasicTableDrivenScanner<Policy>::BasicTableDrivenScanner(std::string_view source)
+    : source(source), dfa(DfaTables::shared()) {}
+
+template <typename Policy>
+void BasicTableDrivenScanner<Policy>::reset(std::string_view source) {
+    this->source.assign(source);
+    clearTokens();
+    brackets.clear();
+}
+
+void DfaTables::initializeTransitionTable() {
     // Single character tokens - direct transitions from START to accepting state
     transitionTable[START][CHAR_LPAREN] = IN_LEFT_PAREN;
     transitionTable[START][CHAR_RPAREN] = IN_RIGHT_PAREN;
     transitionTable[START][CHAR_LBRACE] = IN_LEFT_BRACE;
     transitionTable[START][CHAR_RBRACE] = IN_RIGHT_BRACE;
     transitionTable[START][CHAR_COMMA] = IN_COMMA;
+    transitionTable[START][CHAR_DOT] = IN_DOT;
     transitionTable[START][CHAR_SEMICOLON] = IN_SEMICOLON;
     transitionTable[START][CHAR_PLUS] = IN_PLUS;
     transitionTable[START][CHAR_MINUS] = IN_MINUS;
@@ -239,13 +91,19 @@ void TableDrivenScanner::initializeTransitionTable() {
     transitionTable[IN_IDENTIFIER][CHAR_ALPHA] = IN_IDENTIFIER;
     transitionTable[IN_IDENTIFIER][CHAR_DIGIT] = IN_IDENTIFIER;
     transitionTable[IN_IDENTIFIER][CHAR_UNDERSCORE] = IN_IDENTIFIER;
+    // Non-ASCII lead bytes; scanToken() checks the decoded code point is XID.
+    transitionTable[START][CHAR_UNICODE] = IN_IDENTIFIER;
+    transitionTable[IN_IDENTIFIER][CHAR_UNICODE] = IN_IDENTIFIER;
     
     // Whitespace (stays in START state - ignored)
     transitionTable[START][CHAR_WHITESPACE] = START;
     transitionTable[START][CHAR_NEWLINE] = START;
 }
 
-void TableDrivenScanner::initializeAcceptingStates() {
+void DfaTables::initializeAcceptingStates() {
+    for (int i = 0; i < NUM_STATES; i++) {
+        acceptingStates[i] = TOKEN_ERROR;
+    }
     acceptingStates[IN_LEFT_PAREN] = LEFT_PAREN;
     acceptingStates[IN_RIGHT_PAREN] = RIGHT_PAREN;
     acceptingStates[IN_LEFT_BRACE] = LEFT_BRACE;
@@ -271,8 +129,10 @@ void TableDrivenScanner::initializeAcceptingStates() {
     acceptingStates[IN_IDENTIFIER] = IDENTIFIER;
 }
 
-CharClass TableDrivenScanner::getCharClass(char c) const {
-    switch(c) {
+template <typename Policy>
+CharClass BasicTableDrivenScanner<Policy>::getCharClass(char c) const {
+    unsigned char byte = static_cast<unsigned char>(c);
+    switch(byte) {
         case '(': return CHAR_LPAREN;
         case ')': return CHAR_RPAREN;
         case '{': return CHAR_LBRACE;
@@ -294,128 +154,268 @@ CharClass TableDrivenScanner::getCharClass(char c) const {
         case '\r':
         case '\t': return CHAR_WHITESPACE;
         default:
-            if (isdigit(c)) return CHAR_DIGIT;
-            if (isalpha(c)) return CHAR_ALPHA;
-            if (c == '_') return CHAR_UNDERSCORE;
+            if (byte >= '0' && byte <= '9') return CHAR_DIGIT;
+            if ((byte >= 'a' && byte <= 'z') || (byte >= 'A' && byte <= 'Z')) return CHAR_ALPHA;
+            if (byte == '_') return CHAR_UNDERSCORE;
+            if (byte >= 0x80) return CHAR_UNICODE;
             return CHAR_OTHER;
     }
 }
 
-bool TableDrivenScanner::isAtEnd() const {
+template <typename Policy>
+bool BasicTableDrivenScanner<Policy>::isAtEnd() const {
     return current >= source.length();
 }
 
-char TableDrivenScanner::peek() const {
+template <typename Policy>
+char BasicTableDrivenScanner<Policy>::peek() const {
     if (isAtEnd()) return '\0';
     return source[current];
 }
 
-char TableDrivenScanner::advance() {
+template <typename Policy>
+char BasicTableDrivenScanner<Policy>::advance() {
     return source[current++];
 }
 
-void TableDrivenScanner::addToken(TokenType type) {
-    std::string text = source.substr(start, current - start);
-    tokens.push_back(Token(type, text, line));
+template <typename Policy>
+void BasicTableDrivenScanner<Policy>::newline() {
+    if constexpr (Policy::trackLines) line++;
+}
+
+template <typename Policy>
+bool BasicTableDrivenScanner<Policy>::deferToNextChunk() {
+    if (lastChunk) return false;
+    // Everything after a deferred lexeme is deferred with it.
+    if (resumeAt != source.length()) return true;
+    // Scanning a lexeme looks at most one UTF-8 sequence past it, and
+    // nothing but a string continues past a newline.
+    if (current + 4 <= source.length() ||
+        std::string_view(source).substr(current).find('\n') != std::string_view::npos) {
+        return false;
+    }
+    resumeAt = start;
+    resumeAtLine = startLine;
+    return true;
+}
+
+template <typename Policy>
+void BasicTableDrivenScanner<Policy>::error(const char* message) {
+    if (deferToNextChunk()) return;
+    if constexpr (Policy::reportErrors) {
+        *errors << "[Line " << line << "] Error: " << message << std::endl;
+    }
+}
+
+template <typename Policy>
+void BasicTableDrivenScanner<Policy>::unexpectedCharacter(int length) {
+    if (deferToNextChunk()) return;
+    if constexpr (Policy::reportErrors) {
+        *errors << "[Line " << line << "] Error: Unexpected character '"
+                << std::string_view(source).substr(start, length) << "'." << std::endl;
+    }
+}
+
+template <typename Policy>
+void BasicTableDrivenScanner<Policy>::clearTokens() {
+    if constexpr (Policy::materializeLexemes) lexemes.reclaim(tokens);
+    else tokens.clear();
+}
+
+template <typename Policy>
+void BasicTableDrivenScanner<Policy>::addToken(TokenType type) {
+    addToken(type, start, current - start);
+}
+
+template <typename Policy>
+void BasicTableDrivenScanner<Policy>::addToken(TokenType type, size_t offset, size_t length) {
+    if (deferToNextChunk()) return;
+    if constexpr (std::is_same_v<TokenRecord, TokenType>) {
+        tokens.push_back(type);
+    } else if constexpr (Policy::materializeLexemes) {
+        tokens.emplace_back(type, lexemes.take(std::string_view(source).substr(offset, length)), line);
+    } else {
+        tokens.emplace_back(type, std::string(), line);
+    }
+    if constexpr (Policy::trackBrackets) brackets.add(type, line);
+}
+
+template <typename Policy>
+void BasicTableDrivenScanner<Policy>::whitespace() {
+    while (!isAtEnd()) {
+        CharClass charClass = getCharClass(peek());
+        if (charClass == CHAR_NEWLINE) newline();
+        else if (charClass != CHAR_WHITESPACE) break;
+        advance();
+    }
+    addToken(TOKEN_WHITESPACE);
 }
 
-void TableDrivenScanner::addToken(TokenType type, const std::string& literal) {
-    tokens.push_back(Token(type, literal, line));
+template <typename Policy>
+void BasicTableDrivenScanner<Policy>::acceptToken(State state) {
+    if (state == STRING_END) {
+        size_t length = current - start - 2;
+        if (validateUtf8(source.data() + start + 1, length) != length) {
+            error("Invalid UTF-8 in string.");
+            return;
+        }
+        addToken(STRING, start + 1, length);
+    } else if (state == IN_IDENTIFIER) {
+        addToken(identifierType(std::string_view(source).substr(start, current - start)));
+    } else {
+        addToken(dfa.acceptingStates[state]);
+    }
 }
 
-void TableDrivenScanner::scanToken() {
+template <typename Policy>
+void BasicTableDrivenScanner<Policy>::scanToken() {
     State state = START;
     State lastAcceptingState = ERROR;
-    int lastAcceptingPos = start;
+    size_t lastAcceptingPos = start;
+    int lastAcceptingLine = line;
     
     while (!isAtEnd() && state != ERROR) {
         char c = peek();
         CharClass charClass = getCharClass(c);
-        State nextState = transitionTable[state][charClass];
+        State nextState = dfa.transitionTable[state][charClass];
+        int unicodeLength = 1;
         
-        if (nextState == ERROR) {
-            // No valid transition, check if we're in accepting state
-            if (acceptingStates.find(state) != acceptingStates.end()) {
-                // Process the token
-                if (state == STRING_END) {
-                    std::string value = source.substr(start + 1, current - start - 2);
-                    addToken(STRING, value);
-                } else if (state == IN_NUMBER || state == IN_NUMBER_DECIMAL) {
-                    std::string text = source.substr(start, current - start);
-                    addToken(NUMBER, text);
-                } else if (state == IN_IDENTIFIER) {
-                    std::string text = source.substr(start, current - start);
-                    TokenType type = IDENTIFIER;
-                    if (keywords.find(text) != keywords.end()) {
-                        type = keywords[text];
+        // Whitespace between tokens: skip it (keeping start at the next
+        // lexeme) or, if the policy keeps trivia, emit it as one token.
+        if (state == START && nextState == START) {
+            if constexpr (Policy::keepTrivia) {
+                whitespace();
+                return;
+            }
+            if (charClass == CHAR_NEWLINE) newline();
+            advance();
+            start = current;
+            startLine = line;
+            continue;
+        }
+        
+        // A non-ASCII byte only continues an identifier if it starts a valid
+        // UTF-8 sequence for an XID code point; consume the whole sequence.
+        if (charClass == CHAR_UNICODE && nextState == IN_IDENTIFIER) {
+            uint32_t codepoint;
+            int length = decodeUtf8(source.data() + current, source.data() + source.length(), &codepoint);
+            bool allowed = length > 0 &&
+                (state == START ? isXidStart(codepoint) : isXidContinue(codepoint));
+            if (!allowed) {
+                if (state == START) {
+                    if (length == 0) {
+                        error("Invalid UTF-8 byte.");
+                        length = 1;
+                    } else {
+                        unexpectedCharacter(length);
                     }
-                    addToken(type);
-                } else if (state != IN_COMMENT && state != START) {
-                    addToken(acceptingStates[state]);
+                    current += length;
+                    return;
                 }
-                return;
-            } else if (state == START && charClass == CHAR_OTHER) {
-                // Unexpected character
-                std::cerr << "[Line " << line << "] Error: Unexpected character '" 
-                         << c << "'." << std::endl;
-                advance();
-                return;
+                // End the identifier here; the next scan reports the byte.
+                nextState = ERROR;
+            } else {
+                unicodeLength = length;
             }
-            return;
         }
         
-        // Special handling for newlines in strings and comments
-        if (c == '\n') {
-            line++;
-            if (state == IN_STRING) {
-                // Multi-line string
+        if (nextState == ERROR) {
+            // No valid transition, check if we're in accepting state
+            if (isAccepting(state)) {
+                acceptToken(state);
+                return;
             } else if (state == IN_COMMENT) {
-                // End comment on newline
-                current++;
+                // Comments end before the newline, which is scanned as
+                // whitespace next.
+                if constexpr (Policy::keepTrivia) addToken(TOKEN_COMMENT);
+                else deferToNextChunk();
+                return;
+            } else if (state == START) {
+                // Unexpected character; always consume it so scanning moves on
+                unexpectedCharacter(1);
+                advance();
                 return;
             }
+            backtrack(lastAcceptingState, lastAcceptingPos, lastAcceptingLine);
+            return;
         }
         
-        advance();
+        // Newlines inside multi-line strings
+        if (c == '\n') newline();
+        
+        current += unicodeLength;
         state = nextState;
         
         // Track last accepting state for maximal munch
-        if (acceptingStates.find(state) != acceptingStates.end()) {
+        if (isAccepting(state)) {
             lastAcceptingState = state;
             lastAcceptingPos = current;
+            lastAcceptingLine = line;
         }
     }
     
     // End of input - check if in accepting state
-    if (acceptingStates.find(state) != acceptingStates.end()) {
-        if (state == IN_IDENTIFIER) {
-            std::string text = source.substr(start, current - start);
-            TokenType type = IDENTIFIER;
-            if (keywords.find(text) != keywords.end()) {
-                type = keywords[text];
-            }
-            addToken(type);
-        } else if (state == IN_NUMBER || state == IN_NUMBER_DECIMAL) {
-            std::string text = source.substr(start, current - start);
-            addToken(NUMBER, text);
-        } else if (state == IN_STRING) {
-            std::cerr << "[Line " << line << "] Error: Unterminated string." << std::endl;
-        } else if (state != IN_COMMENT && state != START) {
-            addToken(acceptingStates[state]);
-        }
+    if (state == IN_STRING) {
+        // Not an error yet if the rest of the literal is in the next piece.
+        error("Unterminated string.");
+    } else if (state == IN_COMMENT) {
+        if constexpr (Policy::keepTrivia) addToken(TOKEN_COMMENT);
+        else deferToNextChunk();
+    } else if (isAccepting(state)) {
+        acceptToken(state);
+    } else if (state != START) {
+        backtrack(lastAcceptingState, lastAcceptingPos, lastAcceptingLine);
+    }
+}
+
+template <typename Policy>
+void BasicTableDrivenScanner<Policy>::backtrack(State accepted, size_t position, int acceptedLine) {
+    // Maximal munch ran past the longest token, e.g. "1." in "1.foo" is not
+    // a number but "1" is. Rewind to it; scanning resumes right after.
+    if (accepted == ERROR) {
+        unexpectedCharacter(1);
+        current = start + 1;
+        return;
     }
+    current = position;
+    line = acceptedLine;
+    acceptToken(accepted);
 }
 
-std::vector<Token> TableDrivenScanner::scanTokens() {
+template <typename Policy>
+const std::vector<typename BasicTableDrivenScanner<Policy>::TokenRecord>&
+BasicTableDrivenScanner<Policy>::scanTokens() {
+    return scanChunk(1, true);
+}
+
+template <typename Policy>
+const std::vector<typename BasicTableDrivenScanner<Policy>::TokenRecord>&
+BasicTableDrivenScanner<Policy>::scanChunk(int firstLine, bool last) {
+    // Rescan from the top so calling this twice does not duplicate tokens.
+    clearTokens();
+    brackets.clear();
+    start = 0;
+    current = 0;
+    line = firstLine;
+    lastChunk = last;
+    resumeAt = source.length();
     while (!isAtEnd()) {
         start = current;
+        startLine = line;
         scanToken();
     }
-    tokens.push_back(Token(TOKEN_EOF, "", line));
+    if (!last) {
+        // Moved back if a lexeme was left for the next piece.
+        if (resumeAt == source.length()) resumeAtLine = line;
+        return tokens;
+    }
+    addToken(TOKEN_EOF, current, 0);
+    if constexpr (Policy::trackBrackets) brackets.finish();
     return tokens;
 }
 
-void TableDrivenScanner::printTransitionTable() {
+template <typename Policy>
+void BasicTableDrivenScanner<Policy>::printTransitionTable() {
     std::cout << "\n=== DFA Transition Table ===\n" << std::endl;
     std::cout << "Sample transitions (non-ERROR states):\n" << std::endl;
     
@@ -431,12 +431,12 @@ void TableDrivenScanner::printTransitionTable() {
     const char* charClassNames[] = {
         "'('", "')'", "'{'", "'}'", "','", "'.'", "';'",
         "'+'", "'-'", "'*'", "'!'", "'='", "'>'", "'<'",
-        "'/'", "'\"'", "DIGIT", "ALPHA", "'_'", "NEWLINE", "WHITESPACE", "OTHER"
+        "'/'", "'\"'", "DIGIT", "ALPHA", "'_'", "NEWLINE", "WHITESPACE", "UNICODE", "OTHER"
     };
     
     for (int s = 0; s < 27; s++) {
         for (int c = 0; c < NUM_CHAR_CLASSES; c++) {
-            State next = transitionTable[s][c];
+            State next = dfa.transitionTable[s][c];
             if (next != ERROR && next < 27) {
                 std::cout << stateNames[s] << " + " << charClassNames[c] 
                          << " -> " << stateNames[next] << std::endl;
@@ -445,58 +445,7 @@ void TableDrivenScanner::printTransitionTable() {
     }
 }
 
-int main() {
-    std::cout << "=== Table-Driven Scanner Test ===" << std::endl << std::endl;
-    
-    // Print transition table
-    TableDrivenScanner demo("x");
-    demo.printTransitionTable();
-    std::cout << "\n=== Test Cases ===\n" << std::endl;
-    
-    // Test 1
-    std::cout << "Test 1: Single character tokens" << std::endl;
-    TableDrivenScanner scanner1("(){},;+-*");
-    std::vector<Token> tokens1 = scanner1.scanTokens();
-    for (const auto& token : tokens1) {
-        std::cout << token.toString() << std::endl;
-    }
-    std::cout << std::endl;
-    
-    // Test 2
-    std::cout << "Test 2: Two character tokens" << std::endl;
-    TableDrivenScanner scanner2("! != == = < <= > >=");
-    std::vector<Token> tokens2 = scanner2.scanTokens();
-    for (const auto& token : tokens2) {
-        std::cout << token.toString() << std::endl;
-    }
-    std::cout << std::endl;
-    
-    // Test 3
-    std::cout << "Test 3: Numbers" << std::endl;
-    TableDrivenScanner scanner3("123 456.789");
-    std::vector<Token> tokens3 = scanner3.scanTokens();
-    for (const auto& token : tokens3) {
-        std::cout << token.toString() << std::endl;
-    }
-    std::cout << std::endl;
-    
-    // Test 4
-    std::cout << "Test 4: Identifiers and keywords" << std::endl;
-    TableDrivenScanner scanner4("var x = 10; if while");
-    std::vector<Token> tokens4 = scanner4.scanTokens();
-    for (const auto& token : tokens4) {
-        std::cout << token.toString() << std::endl;
-    }
-    std::cout << std::endl;
-    
-    // Test 5
-    std::cout << "Test 5: Strings" << std::endl;
-    TableDrivenScanner scanner5("\"hello world\"");
-    std::vector<Token> tokens5 = scanner5.scanTokens();
-    for (const auto& token : tokens5) {
-        std::cout << token.toString() << std::endl;
-    }
-    std::cout << std::endl;
-    
-    return 0;
-}
+template class BasicTableDrivenScanner<FullScan>;
+template class BasicTableDrivenScanner<IndexedScan>;
+template class BasicTableDrivenScanner<TypesOnlyScan>;
+template class BasicTableDrivenScanner<TriviaScan>;
@@ -0,0 +1,148 @@
+#ifndef CLOX_SCANNER_TABLE_H
+#define CLOX_SCANNER_TABLE_H
+
+#include <iostream>
+#include <string>
+#include <string_view>
+#include <vector>
+#include "bracket_index.h"
+#include "scan_policy.h"
+#include "token.h"
+
+// DFA States
+enum State {
+    START,
+    // Single character states
+    IN_LEFT_PAREN, IN_RIGHT_PAREN, IN_LEFT_BRACE, IN_RIGHT_BRACE,
+    IN_COMMA, IN_DOT, IN_SEMICOLON, IN_PLUS, IN_MINUS, IN_STAR,
+    // Multi-character states
+    IN_BANG, IN_BANG_EQUAL,
+    IN_EQUAL, IN_EQUAL_EQUAL,
+    IN_GREATER, IN_GREATER_EQUAL,
+    IN_LESS, IN_LESS_EQUAL,
+    IN_SLASH, IN_COMMENT,
+    // Literal states
+    IN_STRING, STRING_END,
+    IN_NUMBER, IN_NUMBER_DOT, IN_NUMBER_DECIMAL,
+    IN_IDENTIFIER,
+    // Special states
+    ACCEPT,
+    ERROR,
+    NUM_STATES
+};
+
+// Character classes for transition table
+enum CharClass {
+    CHAR_LPAREN, CHAR_RPAREN, CHAR_LBRACE, CHAR_RBRACE,
+    CHAR_COMMA, CHAR_DOT, CHAR_SEMICOLON,
+    CHAR_PLUS, CHAR_MINUS, CHAR_STAR,
+    CHAR_BANG, CHAR_EQUAL, CHAR_GREATER, CHAR_LESS,
+    CHAR_SLASH, CHAR_QUOTE,
+    CHAR_DIGIT, CHAR_ALPHA, CHAR_UNDERSCORE,
+    CHAR_NEWLINE, CHAR_WHITESPACE,
+    CHAR_UNICODE,
+    CHAR_OTHER,
+    NUM_CHAR_CLASSES
+};
+
+// Transition and accepting-state tables. They depend only on the grammar,
+// so every scanner (on every thread) shares one read-only copy.
+struct DfaTables {
+    // Transition Table: [current_state][character_class] -> next_state
+    State transitionTable[NUM_STATES][NUM_CHAR_CLASSES];
+    
+    // Accepting states map to token types; TOKEN_ERROR marks the rest.
+    // A flat array indexed by state, so the per-character check is one load.
+    TokenType acceptingStates[NUM_STATES];
+    
+    static const DfaTables& shared();
+    
+private:
+    DfaTables();
+    void initializeTransitionTable();
+    void initializeAcceptingStates();
+};
+
+// DFA-driven scanner. Like BasicScanner, the loop is specialized per
+// Policy; scanner_table.cpp instantiates the policies in scan_policy.h.
+template <typename Policy>
+class BasicTableDrivenScanner {
+public:
+    // Token for most policies, a bare TokenType for TypesOnlyScan.
+    using TokenRecord = typename Policy::TokenRecord;
+
+private:
+    std::string source;
+    // Kept across reset() so repeated scans reuse the buffer's capacity.
+    std::vector<TokenRecord> tokens;
+    // Lexeme buffers of the previous scan, reused by the next one.
+    LexemePool lexemes;
+    // Only filled in when Policy::trackBrackets is set.
+    BracketIndex brackets{Policy::reportErrors};
+    // Byte offsets; size_t so sources past 2 GiB do not overflow.
+    size_t start = 0;
+    size_t current = 0;
+    int line = 1;
+    int startLine = 1;
+    // scanChunk() state: whether more input follows this piece, and where
+    // the next piece has to start.
+    bool lastChunk = true;
+    size_t resumeAt = 0;
+    int resumeAtLine = 1;
+    
+    std::ostream* errors = &std::cerr;
+    const DfaTables& dfa;
+    
+    bool isAccepting(State state) const { return dfa.acceptingStates[state] != TOKEN_ERROR; }
+    
+    CharClass getCharClass(char c) const;
+    bool isAtEnd() const;
+    char peek() const;
+    char advance();
+    void newline();
+    // In a piece with more input to follow, true if the current lexeme
+    // might continue past the end; it is then left for the next piece.
+    bool deferToNextChunk();
+    void error(const char* message);
+    void unexpectedCharacter(int length);
+    void clearTokens();
+    void addToken(TokenType type);
+    void addToken(TokenType type, size_t offset, size_t length);
+    void acceptToken(State state);
+    void backtrack(State accepted, size_t position, int acceptedLine);
+    void whitespace();
+    void scanToken();
+    
+public:
+    BasicTableDrivenScanner() : BasicTableDrivenScanner(std::string_view()) {}
+    BasicTableDrivenScanner(std::string_view source);
+    // Replaces the source; the DFA tables are shared and never rebuilt.
+    // Copies into the retained buffer, so no allocation once it is large
+    // enough.
+    void reset(std::string_view source);
+    const std::vector<TokenRecord>& scanTokens();
+    // Scans one piece of a larger input, so a caller can stream a file
+    // without holding all of it. Pass `last` false for every piece but the
+    // final one. A piece may end anywhere: a lexeme that could continue
+    // past its end (an open string, or anything ending within a few bytes
+    // of it but before a newline) is not emitted but left for the next
+    // piece, which starts at resumeOffset() of this one, on line
+    // resumeLine(). Only the last piece gets a TOKEN_EOF, and brackets are
+    // only matched within one piece.
+    const std::vector<TokenRecord>& scanChunk(int firstLine, bool last);
+    size_t resumeOffset() const { return resumeAt; }
+    int resumeLine() const { return resumeAtLine; }
+    // With a policy that tracks brackets, scanTokens() also pairs them up
+    // and reports unbalanced ones.
+    const BracketIndex& bracketIndex() const { return brackets; }
+    // Diagnostics go to std::cerr unless redirected, e.g. per isolate.
+    void setErrorStream(std::ostream& stream) {
+        errors = &stream;
+        brackets.setErrorStream(stream);
+    }
+    void printTransitionTable();
+};
+
+using TableDrivenScanner = BasicTableDrivenScanner<FullScan>;
+
+#endif
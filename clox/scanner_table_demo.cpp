@@ -0,0 +1,117 @@
+#include <iostream>
+#include <vector>
+#include "scanner_table.h"
+
+int main() {
+    std::cout << "=== Table-Driven Scanner Test ===" << std::endl << std::endl;
+    
+    // Print transition table
+    TableDrivenScanner demo("x");
+    demo.printTransitionTable();
+    std::cout << "\n=== Test Cases ===\n" << std::endl;
+    
+    // Test 1
+    std::cout << "Test 1: Single character tokens" << std::endl;
+    TableDrivenScanner scanner1("(){},;+-*");
+    std::vector<Token> tokens1 = scanner1.scanTokens();
+    for (const auto& token : tokens1) {
+        std::cout << token.toString() << '\n';
+    }
+    std::cout << std::endl;
+    
+    // Test 2
+    std::cout << "Test 2: Two character tokens" << std::endl;
+    TableDrivenScanner scanner2("! != == = < <= > >=");
+    std::vector<Token> tokens2 = scanner2.scanTokens();
+    for (const auto& token : tokens2) {
+        std::cout << token.toString() << '\n';
+    }
+    std::cout << std::endl;
+    
+    // Test 3
+    std::cout << "Test 3: Numbers" << std::endl;
+    TableDrivenScanner scanner3("123 456.789");
+    std::vector<Token> tokens3 = scanner3.scanTokens();
+    for (const auto& token : tokens3) {
+        std::cout << token.toString() << '\n';
+    }
+    std::cout << std::endl;
+    
+    // Test 4
+    std::cout << "Test 4: Identifiers and keywords" << std::endl;
+    TableDrivenScanner scanner4("var x = 10; if while");
+    std::vector<Token> tokens4 = scanner4.scanTokens();
+    for (const auto& token : tokens4) {
+        std::cout << token.toString() << '\n';
+    }
+    std::cout << std::endl;
+    
+    // Test 5
+    std::cout << "Test 5: Strings" << std::endl;
+    TableDrivenScanner scanner5("\"hello world\"");
+    std::vector<Token> tokens5 = scanner5.scanTokens();
+    for (const auto& token : tokens5) {
+        std::cout << token.toString() << '\n';
+    }
+    std::cout << std::endl;
+    
+    // Test 6
+    std::cout << "Test 6: Reusing a scanner with reset()" << std::endl;
+    TableDrivenScanner reused;
+    const char* snippets[] = {"var a = 1;", "print a;", "print a;"};
+    for (const char* snippet : snippets) {
+        reused.reset(snippet);
+        for (const auto& token : reused.scanTokens()) {
+            std::cout << token.toString() << '\n';
+        }
+    }
+    std::cout << "Rescan without reset: " << reused.scanTokens().size() << " tokens" << std::endl;
+    std::cout << std::endl;
+    
+    // Test 7
+    std::cout << "Test 7: UTF-8 identifiers and strings" << std::endl;
+    TableDrivenScanner scanner7("var caf\u00e9 = \"h\u00e9llo \u4e16\u754c\";\nprint \u03c0\u0394 \u20ac \xff;\n\"bad \xc0\xaf\" x");
+    for (const auto& token : scanner7.scanTokens()) {
+        std::cout << token.toString() << '\n';
+    }
+    std::cout << std::endl;
+    
+    // Test 8
+    std::cout << "Test 8: Bracket matching" << std::endl;
+    BasicTableDrivenScanner<IndexedScan> bracketScanner("fun f(a) { if (a) { print (a); } }");
+    const auto& bracketTokens = bracketScanner.scanTokens();
+    const BracketIndex& index = bracketScanner.bracketIndex();
+    for (int i = 0; i < static_cast<int>(bracketTokens.size()); i++) {
+        if (index.partnerOf(i) >= 0) {
+            std::cout << i << " " << bracketTokens[i].lexeme << " <-> " << index.partnerOf(i) << '\n';
+        }
+    }
+    bracketScanner.reset("(a { b ) }\n}");
+    bracketScanner.scanTokens();
+    std::cout << "Unbalanced errors: " << bracketScanner.bracketIndex().errorCount() << std::endl;
+    std::cout << std::endl;
+    
+    // Test 9
+    std::cout << "Test 9: Scan policies" << std::endl;
+    BasicTableDrivenScanner<TriviaScan> triviaScanner("var a; // note\n  print a;");
+    for (const auto& token : triviaScanner.scanTokens()) {
+        std::cout << token.toString() << '\n';
+    }
+    BasicTableDrivenScanner<TypesOnlyScan> typesScanner("var a = \"x\";\n@ print a;");
+    // TypesOnlyScan emits bare TokenTypes rather than Tokens.
+    for (TokenType type : typesScanner.scanTokens()) {
+        std::cout << tokenTypeName(type) << ' ';
+    }
+    std::cout << '\n';
+    std::cout << std::endl;
+    
+    // Test 10
+    std::cout << "Test 10: Backtracking to the last accepting state" << std::endl;
+    TableDrivenScanner backtrackScanner("1.foo 12.");
+    for (const auto& token : backtrackScanner.scanTokens()) {
+        std::cout << token.toString() << '\n';
+    }
+    std::cout << std::endl;
+    
+    return 0;
+}
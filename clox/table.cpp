@@ -0,0 +1,144 @@
+#include <cstring>
+#include "object.h"
+#include "table.h"
+
+// Returns the slot holding `key`, or the slot where it should be inserted:
+// the first tombstone passed on the way, else the empty slot that ended the
+// probe. The capacity is always a power of two, so wrapping is a mask.
+int Table::findSlot(ObjString* key) const {
+    uint32_t mask = static_cast<uint32_t>(entries.size()) - 1;
+    uint32_t index = key->hash & mask;
+    int tombstone = -1;
+    for (;;) {
+        const Entry& entry = entries[index];
+        if (entry.key == key) return static_cast<int>(index);
+        if (entry.key == nullptr) {
+            if (entry.value.isNil()) return tombstone != -1 ? tombstone : static_cast<int>(index);
+            if (tombstone == -1) tombstone = static_cast<int>(index);
+        }
+        index = (index + 1) & mask;
+    }
+}
+
+void Table::adjustCapacity(int capacity) {
+    std::vector<Entry> old;
+    old.swap(entries);
+    entries.assign(capacity, Entry{nullptr, Value::nil()});
+
+    // Tombstones are dropped on rehash.
+    count = 0;
+    for (const Entry& entry : old) {
+        if (entry.key == nullptr) continue;
+        entries[findSlot(entry.key)] = entry;
+        count++;
+    }
+}
+
+bool Table::get(ObjString* key, Value* value) const {
+    if (live == 0) return false;
+    const Entry& entry = entries[findSlot(key)];
+    if (entry.key == nullptr) return false;
+    *value = entry.value;
+    return true;
+}
+
+bool Table::set(ObjString* key, Value value) {
+    if (count + 1 > capacity() * MAX_LOAD) {
+        adjustCapacity(capacity() < 8 ? 8 : capacity() * 2);
+    }
+
+    Entry& entry = entries[findSlot(key)];
+    bool isNewKey = entry.key == nullptr;
+    // Reusing a tombstone does not change the load.
+    if (isNewKey && entry.value.isNil()) count++;
+    if (isNewKey) live++;
+    entry.key = key;
+    entry.value = value;
+    return isNewKey;
+}
+
+bool Table::remove(ObjString* key) {
+    if (live == 0) return false;
+    Entry& entry = entries[findSlot(key)];
+    if (entry.key == nullptr) return false;
+
+    // Leave a tombstone so probe sequences through this slot still work.
+    entry.key = nullptr;
+    entry.value = Value::boolean(true);
+    live--;
+    return true;
+}
+
+void Table::addAll(const Table& from) {
+    for (const Entry& entry : from.entries) {
+        if (entry.key != nullptr) set(entry.key, entry.value);
+    }
+}
+
+void Table::clear() {
+    for (Entry& entry : entries) entry = Entry{nullptr, Value::nil()};
+    count = 0;
+    live = 0;
+}
+
+ObjString* Table::findString(const char* chars, int length, uint32_t hash) const {
+    if (live == 0) return nullptr;
+    uint32_t mask = static_cast<uint32_t>(entries.size()) - 1;
+    uint32_t index = hash & mask;
+    for (;;) {
+        const Entry& entry = entries[index];
+        if (entry.key == nullptr) {
+            // Stop at an empty non-tombstone slot.
+            if (entry.value.isNil()) return nullptr;
+        } else if (entry.key->length == length && entry.key->hash == hash &&
+                   memcmp(entry.key->chars(), chars, length) == 0) {
+            return entry.key;
+        }
+        index = (index + 1) & mask;
+    }
+}
+
+void Table::removeUnmarked() {
+    for (Entry& entry : entries) {
+        if (entry.key != nullptr && !entry.key->obj.isMarked) {
+            entry.key = nullptr;
+            entry.value = Value::boolean(true);
+            live--;
+        }
+    }
+}
+
+bool Table::getCached(ObjString* key, InlineCache& cache, Value* value) const {
+    // The key check alone makes a hit correct, so one cache serves every
+    // table that keeps this key in the same slot, e.g. instances whose
+    // fields were added in the same order.
+    if (cache.index >= 0 && cache.index < capacity() && entries[cache.index].key == key) {
+        cache.hits++;
+        *value = entries[cache.index].value;
+        return true;
+    }
+
+    cache.misses++;
+    if (live == 0) return false;
+    int index = findSlot(key);
+    if (entries[index].key == nullptr) return false;
+    cache.index = index;
+    *value = entries[index].value;
+    return true;
+}
+
+bool Table::setCached(ObjString* key, Value value, InlineCache& cache) {
+    if (cache.index >= 0 && cache.index < capacity() && entries[cache.index].key == key) {
+        cache.hits++;
+        entries[cache.index].value = value;
+        return true;
+    }
+
+    cache.misses++;
+    if (live == 0) return false;
+    int index = findSlot(key);
+    if (entries[index].key == nullptr) return false;
+    cache.index = index;
+    entries[index].value = value;
+    return true;
+}
@@ -0,0 +1,65 @@
+#ifndef CLOX_TABLE_H
+#define CLOX_TABLE_H
+
+#include <cstdint>
+#include <vector>
+#include "value.h"
+
+struct ObjString;
+
+// Remembers the slot where a key was found the last time one instruction
+// looked it up. If the slot still holds that key, in this table or any
+// other with the same layout, the next lookup reads it directly with no
+// hashing or probing.
+struct InlineCache {
+    int index = -1;
+    uint32_t hits = 0;
+    uint32_t misses = 0;
+};
+
+// Open-addressing hash table keyed by interned strings, with linear probing
+// and tombstones for deletion. Keys compare by pointer and hash with the
+// hash cached in the ObjString, so a lookup never touches the characters.
+class Table
+{
+public:
+    struct Entry {
+        ObjString* key;     // nullptr for empty slots and tombstones
+        Value value;        // true in a tombstone, nil in an empty slot
+    };
+
+private:
+    static constexpr double MAX_LOAD = 0.75;
+
+    std::vector<Entry> entries;
+    int count = 0;          // live entries plus tombstones
+    int live = 0;
+
+    int findSlot(ObjString* key) const;
+    void adjustCapacity(int capacity);
+
+public:
+    bool get(ObjString* key, Value* value) const;
+    // Returns true if the key was not already present.
+    bool set(ObjString* key, Value value);
+    bool remove(ObjString* key);
+    void addAll(const Table& from);
+    // Removes every entry but keeps the allocated slots.
+    void clear();
+    // Looks a string up by contents; the interner uses this to dedupe.
+    ObjString* findString(const char* chars, int length, uint32_t hash) const;
+    // Deletes entries whose key the collector did not mark; this is what
+    // makes the heap's string table weak.
+    void removeUnmarked();
+
+    // Cached variants for per-instruction global and property access.
+    bool getCached(ObjString* key, InlineCache& cache, Value* value) const;
+    // Only updates existing keys; returns false if the key is missing.
+    bool setCached(ObjString* key, Value value, InlineCache& cache);
+
+    int size() const { return live; }
+    int capacity() const { return static_cast<int>(entries.size()); }
+    const Entry& entryAt(int index) const { return entries[index]; }
+};
+
+#endif
@@ -0,0 +1,95 @@
+#include <iostream>
+#include <string>
+#include <vector>
+#include "memory.h"
+#include "table.h"
+
+static void printLookup(Table& table, ObjString* key) {
+    Value value;
+    std::cout << key->view() << ": ";
+    if (table.get(key, &value)) std::cout << value.as.number << '\n';
+    else std::cout << "missing\n";
+}
+
+int main() {
+    std::cout << "=== Hash Table Test ===" << std::endl << std::endl;
+
+    // Test 1
+    std::cout << "Test 1: Interning" << std::endl;
+    Heap strings;
+    ObjString* a = strings.intern("count");
+    std::string built = std::string("cou") + "nt";
+    ObjString* b = strings.intern(built);
+    std::cout << "Same object: " << (a == b ? "yes" : "no") << '\n';
+    std::cout << "Interned strings: " << strings.internedStrings() << std::endl;
+    std::cout << std::endl;
+
+    // Test 2
+    std::cout << "Test 2: Set, get and overwrite" << std::endl;
+    Table globals;
+    ObjString* x = strings.intern("x");
+    ObjString* y = strings.intern("y");
+    std::cout << "New key: " << globals.set(x, Value::number(1)) << '\n';
+    std::cout << "New key: " << globals.set(x, Value::number(2)) << '\n';
+    globals.set(y, Value::number(3));
+    printLookup(globals, x);
+    printLookup(globals, y);
+    printLookup(globals, a);
+    std::cout << std::endl;
+
+    // Test 3
+    std::cout << "Test 3: Tombstones" << std::endl;
+    std::cout << "Removed: " << globals.remove(x) << '\n';
+    std::cout << "Removed again: " << globals.remove(x) << '\n';
+    printLookup(globals, x);
+    printLookup(globals, y);
+    globals.set(x, Value::number(4));
+    printLookup(globals, x);
+    std::cout << "Size: " << globals.size() << std::endl;
+    std::cout << std::endl;
+
+    // Test 4
+    std::cout << "Test 4: Growth" << std::endl;
+    Table fields;
+    for (int i = 0; i < 1000; i++) {
+        fields.set(strings.intern("field" + std::to_string(i)), Value::number(i));
+    }
+    for (int i = 0; i < 1000; i += 2) {
+        fields.remove(strings.intern("field" + std::to_string(i)));
+    }
+    printLookup(fields, strings.intern("field999"));
+    printLookup(fields, strings.intern("field998"));
+    std::cout << "Size: " << fields.size() << ", capacity: " << fields.capacity() << std::endl;
+    std::cout << std::endl;
+
+    // Test 5
+    std::cout << "Test 5: Inline cache" << std::endl;
+    InlineCache cache;
+    Value value;
+    for (int i = 0; i < 5; i++) globals.getCached(y, cache, &value);
+    globals.setCached(y, Value::number(5), cache);
+    globals.getCached(y, cache, &value);
+    std::cout << "y: " << value.as.number << '\n';
+    // Adding another key leaves y in its slot, so lookups keep hitting.
+    globals.set(strings.intern("z"), Value::number(6));
+    for (int i = 0; i < 3; i++) globals.getCached(y, cache, &value);
+    std::cout << "Hits: " << cache.hits << ", misses: " << cache.misses << '\n';
+    std::cout << "Missing key: " << globals.getCached(a, cache, &value) << '\n';
+    // One property cache serves every instance with the same field layout,
+    // as in p.x over a list of points.
+    std::vector<Table> points(100);
+    for (int i = 0; i < 100; i++) {
+        points[i].set(x, Value::number(i));
+        points[i].set(y, Value::number(-i));
+    }
+    InlineCache fieldCache;
+    double sum = 0;
+    for (const Table& point : points) {
+        point.getCached(x, fieldCache, &value);
+        sum += value.as.number;
+    }
+    std::cout << "Sum of x: " << sum << ", hits: " << fieldCache.hits
+              << ", misses: " << fieldCache.misses << std::endl;
+
+    return 0;
+}
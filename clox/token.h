@@ -0,0 +1,162 @@
+#ifndef CLOX_TOKEN_H
+#define CLOX_TOKEN_H
+
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+enum TokenType {
+    //single-character tokens
+    LEFT_PAREN, RIGHT_PAREN,
+    LEFT_BRACE, RIGHT_BRACE,
+    COMMA, DOT, SEMICOLON,
+    PLUS, MINUS, STAR, SLASH,
+    //one or two character tokens
+    BANG, BANG_EQUAL,
+    EQUAL, EQUAL_EQUAL,
+    GREATER, GREATER_EQUAL,
+    LESS, LESS_EQUAL,
+    //literals
+    IDENTIFIER, STRING, NUMBER,
+    //keywords
+    AND, CLASS, ELSE, FALSE, FUN, FOR, IF, NIL, OR, PRINT,
+    PRIVATE, RETURN, SUPER, THIS, TRUE, VAR, WHILE,
+    //end of file
+    TOKEN_EOF,
+    TOKEN_ERROR,
+    //trivia, only emitted by scan policies that keep it
+    TOKEN_WHITESPACE, TOKEN_COMMENT,
+    NUM_TOKEN_TYPES
+};
+
+// Resolves reserved words without allocating: switch on the first letter
+// (and second, where several keywords share one), then compare the rest.
+inline TokenType checkKeyword(std::string_view text, size_t offset,
+                              std::string_view rest, TokenType type) {
+    if (text.size() == offset + rest.size() && text.substr(offset) == rest) return type;
+    return IDENTIFIER;
+}
+
+inline TokenType identifierType(std::string_view text) {
+    if (text.empty()) return IDENTIFIER;
+    switch (text[0]) {
+        case 'a': return checkKeyword(text, 1, "nd", AND);
+        case 'c': return checkKeyword(text, 1, "lass", CLASS);
+        case 'e': return checkKeyword(text, 1, "lse", ELSE);
+        case 'f':
+            if (text.size() > 1) {
+                switch (text[1]) {
+                    case 'a': return checkKeyword(text, 2, "lse", FALSE);
+                    case 'o': return checkKeyword(text, 2, "r", FOR);
+                    case 'u': return checkKeyword(text, 2, "n", FUN);
+                }
+            }
+            break;
+        case 'i': return checkKeyword(text, 1, "f", IF);
+        case 'n': return checkKeyword(text, 1, "il", NIL);
+        case 'o': return checkKeyword(text, 1, "r", OR);
+        case 'p':
+            if (text.size() > 1) {
+                switch (text[1]) {
+                    case 'r':
+                        if (text.size() > 2 && text[2] == 'i') {
+                            if (text.size() > 3 && text[3] == 'n') return checkKeyword(text, 4, "t", PRINT);
+                            return checkKeyword(text, 3, "vate", PRIVATE);
+                        }
+                        break;
+                }
+            }
+            break;
+        case 'r': return checkKeyword(text, 1, "eturn", RETURN);
+        case 's': return checkKeyword(text, 1, "uper", SUPER);
+        case 't':
+            if (text.size() > 1) {
+                switch (text[1]) {
+                    case 'h': return checkKeyword(text, 2, "is", THIS);
+                    case 'r': return checkKeyword(text, 2, "ue", TRUE);
+                }
+            }
+            break;
+        case 'v': return checkKeyword(text, 1, "ar", VAR);
+        case 'w': return checkKeyword(text, 1, "hile", WHILE);
+    }
+    return IDENTIFIER;
+}
+
+// Indexed by TokenType; must stay in the same order as the enum.
+inline constexpr std::string_view tokenTypeNames[NUM_TOKEN_TYPES] = {
+    "LEFT_PAREN", "RIGHT_PAREN",
+    "LEFT_BRACE", "RIGHT_BRACE",
+    "COMMA", "DOT", "SEMICOLON",
+    "PLUS", "MINUS", "STAR", "SLASH",
+    "BANG", "BANG_EQUAL",
+    "EQUAL", "EQUAL_EQUAL",
+    "GREATER", "GREATER_EQUAL",
+    "LESS", "LESS_EQUAL",
+    "IDENTIFIER", "STRING", "NUMBER",
+    "AND", "CLASS", "ELSE", "FALSE", "FUN", "FOR", "IF", "NIL", "OR", "PRINT",
+    "PRIVATE", "RETURN", "SUPER", "THIS", "TRUE", "VAR", "WHILE",
+    "TOKEN_EOF",
+    "TOKEN_ERROR",
+    "TOKEN_WHITESPACE", "TOKEN_COMMENT"
+};
+
+// Allocation-free name lookup for hot paths such as token dumps.
+inline constexpr std::string_view tokenTypeName(TokenType type) {
+    if (type < 0 || type >= NUM_TOKEN_TYPES) return "UNKNOWN";
+    return tokenTypeNames[type];
+}
+
+inline std::string tokenTypeToString(TokenType type) {
+    return std::string(tokenTypeName(type));
+}
+
+class Token
+{
+public:
+    TokenType type;
+    std::string lexeme;
+    int line;
+    Token(TokenType type, std::string lexeme, int line)
+        : type(type), lexeme(std::move(lexeme)), line(line) {}
+
+    std::string toString() const {
+        std::string_view name = tokenTypeName(type);
+        std::string lineText = std::to_string(line);
+        std::string result;
+        result.reserve(name.size() + lexeme.size() + lineText.size() + 2);
+        result.append(name).append(" ").append(lexeme).append(" ").append(lineText);
+        return result;
+    }
+};
+
+// Keeps the lexeme buffers of cleared tokens so the next scan can reuse
+// them. Scanning the same or similar input again then assigns into storage
+// that already exists instead of allocating a string per long lexeme.
+class LexemePool
+{
+private:
+    std::vector<std::string> spare;
+
+public:
+    // Takes the lexemes out of `tokens` and clears it. Reversed, so the
+    // next scan's first token gets the buffer of this scan's first token.
+    void reclaim(std::vector<Token>& tokens) {
+        for (auto token = tokens.rbegin(); token != tokens.rend(); ++token) {
+            spare.push_back(std::move(token->lexeme));
+        }
+        tokens.clear();
+    }
+    std::string take(std::string_view text) {
+        std::string lexeme;
+        if (!spare.empty()) {
+            lexeme = std::move(spare.back());
+            spare.pop_back();
+        }
+        lexeme.assign(text);
+        return lexeme;
+    }
+};
+
+#endif
@@ -0,0 +1,77 @@
+#include <cstring>
+#include "utf8.h"
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+int decodeUtf8(const char* start, const char* end, uint32_t* codepoint) {
+    const unsigned char* p = reinterpret_cast<const unsigned char*>(start);
+    size_t available = end - start;
+    if (available == 0) return 0;
+
+    unsigned char lead = p[0];
+    if (lead < 0x80) {
+        *codepoint = lead;
+        return 1;
+    }
+
+    int length;
+    uint32_t value;
+    uint32_t minimum;
+    if ((lead & 0xe0) == 0xc0) {
+        length = 2; value = lead & 0x1f; minimum = 0x80;
+    } else if ((lead & 0xf0) == 0xe0) {
+        length = 3; value = lead & 0x0f; minimum = 0x800;
+    } else if ((lead & 0xf8) == 0xf0) {
+        length = 4; value = lead & 0x07; minimum = 0x10000;
+    } else {
+        return 0;
+    }
+    if (available < static_cast<size_t>(length)) return 0;
+
+    for (int i = 1; i < length; i++) {
+        if ((p[i] & 0xc0) != 0x80) return 0;
+        value = (value << 6) | (p[i] & 0x3f);
+    }
+    // Reject overlong forms, UTF-16 surrogates and values past U+10FFFF.
+    if (value < minimum || value > 0x10ffff) return 0;
+    if (value >= 0xd800 && value <= 0xdfff) return 0;
+
+    *codepoint = value;
+    return length;
+}
+
+// Skips the leading run of ASCII bytes, a block at a time.
+static size_t skipAscii(const unsigned char* data, size_t length) {
+    size_t i = 0;
+#if defined(__SSE2__)
+    for (; i + 16 <= length; i += 16) {
+        __m128i block = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i));
+        int highBits = _mm_movemask_epi8(block);
+        if (highBits != 0) return i + __builtin_ctz(highBits);
+    }
+#endif
+    for (; i + 8 <= length; i += 8) {
+        uint64_t word;
+        memcpy(&word, data + i, sizeof(word));
+        if (word & 0x8080808080808080ull) break;
+    }
+    while (i < length && data[i] < 0x80) i++;
+    return i;
+}
+
+size_t validateUtf8(const char* data, size_t length) {
+    const unsigned char* bytes = reinterpret_cast<const unsigned char*>(data);
+    size_t i = 0;
+    while (i < length) {
+        i += skipAscii(bytes + i, length - i);
+        if (i == length) break;
+
+        uint32_t codepoint;
+        int sequence = decodeUtf8(data + i, data + length, &codepoint);
+        if (sequence == 0) return i;
+        i += sequence;
+    }
+    return length;
+}
@@ -0,0 +1,20 @@
+#ifndef CLOX_UTF8_H
+#define CLOX_UTF8_H
+
+#include <cstddef>
+#include <cstdint>
+
+// Decodes one UTF-8 sequence starting at `start`. Returns its length in
+// bytes and stores the code point, or returns 0 for an invalid, overlong,
+// surrogate or truncated sequence.
+int decodeUtf8(const char* start, const char* end, uint32_t* codepoint);
+
+// Returns the offset of the first byte that is not part of a valid UTF-8
+// sequence, or `length` if the whole buffer is valid.
+size_t validateUtf8(const char* data, size_t length);
+
+// Unicode identifier properties (UAX #31).
+bool isXidStart(uint32_t codepoint);
+bool isXidContinue(uint32_t codepoint);
+
+#endif
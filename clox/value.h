@@ -0,0 +1,45 @@
+#ifndef CLOX_VALUE_H
+#define CLOX_VALUE_H
+
+struct Obj;
+
+enum ValueType {
+    VAL_NIL,
+    VAL_BOOL,
+    VAL_NUMBER,
+    VAL_OBJ
+};
+
+// A runtime value: a small tagged union, passed around by value.
+struct Value {
+    ValueType type;
+    union {
+        bool boolean;
+        double number;
+        Obj* obj;
+    } as;
+
+    static Value nil() { Value value; value.type = VAL_NIL; value.as.number = 0; return value; }
+    static Value boolean(bool b) { Value value; value.type = VAL_BOOL; value.as.boolean = b; return value; }
+    static Value number(double n) { Value value; value.type = VAL_NUMBER; value.as.number = n; return value; }
+    static Value object(Obj* o) { Value value; value.type = VAL_OBJ; value.as.obj = o; return value; }
+
+    bool isNil() const { return type == VAL_NIL; }
+    bool isBool() const { return type == VAL_BOOL; }
+    bool isNumber() const { return type == VAL_NUMBER; }
+    bool isObj() const { return type == VAL_OBJ; }
+};
+
+// Strings are interned, so object equality is identity.
+inline bool valuesEqual(Value a, Value b) {
+    if (a.type != b.type) return false;
+    switch (a.type) {
+        case VAL_NIL: return true;
+        case VAL_BOOL: return a.as.boolean == b.as.boolean;
+        case VAL_NUMBER: return a.as.number == b.as.number;
+        case VAL_OBJ: return a.as.obj == b.as.obj;
+    }
+    return false;
+}
+
+#endif